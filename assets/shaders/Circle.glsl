@@ -33,8 +33,11 @@ layout (location = 0) out vec4 FragColor;
 
 void main() {
   float distance = 1.0 - length(vLocalPosition);
-  float circle = smoothstep(0.0, vFade, distance);
-  circle *= smoothstep(vThickness + vFade, vThickness, distance);
+
+  // At least a pixel wide, so edges stay smooth without multisampling.
+  float fade = max(vFade, fwidth(distance));
+  float circle = smoothstep(0.0, fade, distance);
+  circle *= smoothstep(vThickness + fade, vThickness, distance);
 
   if (circle == 0.0) {
     discard;
@@ -0,0 +1,56 @@
+@type vertex
+
+layout (location = 0) in vec2  aCorner;
+
+// Per segment.
+layout (location = 1) in vec2  aFrom;
+layout (location = 2) in vec2  aTo;
+layout (location = 3) in vec4  aColor;
+layout (location = 4) in float aWidth;
+
+uniform mat4 uProjectionView;
+
+out float vDistance;
+flat out vec4  vColor;
+flat out float vHalfWidth;
+
+void main() {
+    vec2 delta = aTo - aFrom;
+    float len = length(delta);
+    vec2 direction = len > 0.0 ? delta / len : vec2(1.0, 0.0);
+    vec2 normal = vec2(-direction.y, direction.x);
+
+    // Half a pixel more on each side to fade out in, the ends are square.
+    float halfWidth = aWidth * 0.5;
+    float extent = halfWidth + 0.5;
+    vec2 from = aFrom - direction * halfWidth;
+    vec2 to   = aTo   + direction * halfWidth;
+    vec2 position = mix(from, to, aCorner.x) + normal * (aCorner.y * extent);
+
+    vDistance  = aCorner.y * extent;
+    vColor     = aColor;
+    vHalfWidth = halfWidth;
+
+    gl_Position = uProjectionView * vec4(position, 0.0f, 1.0f);
+}
+
+@type fragment
+
+precision mediump float;
+
+in float vDistance;
+flat in vec4  vColor;
+flat in float vHalfWidth;
+
+layout (location = 0) out vec4 FragColor;
+
+void main() {
+  float coverage = clamp(vHalfWidth - abs(vDistance) + 0.5, 0.0, 1.0);
+
+  if (coverage == 0.0) {
+    discard;
+  }
+
+  FragColor = vColor;
+  FragColor.a *= coverage;
+}
@@ -0,0 +1,37 @@
+@type vertex
+
+layout (location = 0) in vec2 aPosition;
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in vec2 aEdge;
+
+out vec4 vColor;
+out vec2 vEdge;
+
+void main() {
+    vColor = aColor;
+    vEdge  = aEdge;
+
+    gl_Position = vec4(aPosition, 0.0f, 1.0f);
+}
+
+@type fragment
+
+precision mediump float;
+
+in vec4 vColor;
+in vec2 vEdge;
+
+layout (location = 0) out vec4 FragColor;
+
+void main() {
+  // x is the distance from the middle of the line, y half its width. The
+  // geometry extends half a pixel past the edge to fade out in.
+  float coverage = clamp(vEdge.y - abs(vEdge.x) + 0.5, 0.0, 1.0);
+
+  if (coverage == 0.0) {
+    discard;
+  }
+
+  FragColor = vColor;
+  FragColor.a *= coverage;
+}
@@ -6,12 +6,31 @@ layout (location = 2) in vec2 aTexCoord;
 layout (location = 3) in uint aTexIndex;
 layout (location = 4) in uint aEffectMode;
 layout (location = 5) in vec2 aQuadSize;
+layout (location = 6) in vec4 aRadii;
+layout (location = 7) in vec4 aShape;
+layout (location = 8) in vec2 aShadowOffset;
+layout (location = 9) in uint aBorderColor;
+layout (location = 10) in uint aShadowColor;
 
 out vec4 vColor;
 out vec2 vTexCoord;
 flat out uint vTexIndex;
 flat out uint vEffectMode;
 flat out vec2 vQuadSize;
+flat out vec4 vRadii;
+flat out vec4 vShape;
+flat out vec2 vShadowOffset;
+flat out vec4 vBorderColor;
+flat out vec4 vShadowColor;
+
+vec4 unpackColor(uint color) {
+   return vec4(
+      float((color >> 24u) & 255u),
+      float((color >> 16u) & 255u),
+      float((color >>  8u) & 255u),
+      float((color >>  0u) & 255u)
+   ) / 255.0f;
+}
 
 void main() {
    vColor      = aColor;
@@ -19,6 +38,11 @@ void main() {
    vTexIndex   = aTexIndex;
    vEffectMode = aEffectMode;
    vQuadSize   = aQuadSize;
+   vRadii        = aRadii;
+   vShape        = aShape;
+   vShadowOffset = aShadowOffset;
+   vBorderColor  = unpackColor(aBorderColor);
+   vShadowColor  = unpackColor(aShadowColor);
    gl_Position = vec4(aPosition, 0.0f, 1.0f);
 }
 
@@ -33,13 +57,25 @@ in vec2 vTexCoord;
 flat in uint vTexIndex;
 flat in uint vEffectMode;
 flat in vec2 vQuadSize;
+flat in vec4 vRadii;
+flat in vec4 vShape;
+flat in vec2 vShadowOffset;
+flat in vec4 vBorderColor;
+flat in vec4 vShadowColor;
 
 uniform sampler2D uTextures[16];
 
 uniform float uTime;
 uniform vec2  uResolution;
 
+// Texture index of solid fills, see Renderer2D::SOLID_TEXTURE_INDEX.
+const uint SOLID = 255u;
+
 vec4 getTextureColor() {
+  if (vTexIndex == SOLID) {
+    return vec4(1.0f);
+  }
+
   // Reason for the switch cases: 
   // https://stackoverflow.com/questions/72648980/opengl-sampler2d-array
   vec4 color;
@@ -64,6 +100,38 @@ vec4 getTextureColor() {
   return color;
 }
 
+// Samples a pixel font through linear filtering so it stays sharp, blending
+// only over the screen pixel that straddles a texel edge.
+vec4 textureSmooth(sampler2D image, vec2 uvWidth) {
+  vec2 size  = vec2(textureSize(image, 0));
+  vec2 texel = vTexCoord * size;
+  vec2 seam  = floor(texel + 0.5f);
+  texel = seam + clamp((texel - seam) / max(uvWidth * size, vec2(0.0001f)), -0.5f, 0.5f);
+  return texture(image, texel / size);
+}
+
+vec4 getTextColor(vec2 uvWidth) {
+  switch (vTexIndex) {
+    case  0u: return textureSmooth(uTextures[ 0], uvWidth);
+    case  1u: return textureSmooth(uTextures[ 1], uvWidth);
+    case  2u: return textureSmooth(uTextures[ 2], uvWidth);
+    case  3u: return textureSmooth(uTextures[ 3], uvWidth);
+    case  4u: return textureSmooth(uTextures[ 4], uvWidth);
+    case  5u: return textureSmooth(uTextures[ 5], uvWidth);
+    case  6u: return textureSmooth(uTextures[ 6], uvWidth);
+    case  7u: return textureSmooth(uTextures[ 7], uvWidth);
+    case  8u: return textureSmooth(uTextures[ 8], uvWidth);
+    case  9u: return textureSmooth(uTextures[ 9], uvWidth);
+    case 10u: return textureSmooth(uTextures[10], uvWidth);
+    case 11u: return textureSmooth(uTextures[11], uvWidth);
+    case 12u: return textureSmooth(uTextures[12], uvWidth);
+    case 13u: return textureSmooth(uTextures[13], uvWidth);
+    case 14u: return textureSmooth(uTextures[14], uvWidth);
+    case 15u: return textureSmooth(uTextures[15], uvWidth);
+  }
+  return vec4(1.0f);
+}
+
 void effect_striped(out vec4 fragColor) {
   vec2 frag_uv = gl_FragCoord.xy / uResolution;
   vec3 color_gap = vec3(0.25);
@@ -121,11 +189,59 @@ void effect_roundedCorners(out vec4 fragColor) {
    fragColor = mix(fromColor, toColor, blendAmount);
 }
 
+float cornerRadius(vec2 p, vec4 radii) {
+   if (p.x < 0.0f) {
+      return p.y < 0.0f ? radii.x : radii.w;
+   }
+   return p.y < 0.0f ? radii.y : radii.z;
+}
+
+// vTexCoord is the position relative to the center, vShape holds the inner
+// and outer border width and the shadow blur. `uvWidth` is the pixel footprint
+// from main(), vTexCoord is in pixels so it is the width of the distance too.
+void effect_shape(vec2 uvWidth, out vec4 fragColor) {
+   vec2  p        = vTexCoord;
+   vec2  halfSize = vQuadSize / 2.0f;
+   float radius   = cornerRadius(p, vRadii);
+
+   float dist = RectSDF(p, halfSize, radius);
+   float aa   = max(0.5f * length(uvWidth), 0.0001f);
+
+   float shapeCoverage = 1.0f - smoothstep(-aa, aa, dist - vShape.y);
+   float fillCoverage  = 1.0f - smoothstep(-aa, aa, dist + vShape.x);
+
+   vec4 body = mix(vBorderColor, vColor, fillCoverage);
+   body.a *= shapeCoverage;
+
+   vec4 shadow = vec4(0.0f);
+   if (vShadowColor.a > 0.0f) {
+      vec2  q          = p - vShadowOffset;
+      float shadowDist = RectSDF(q, halfSize, cornerRadius(q, vRadii)) - vShape.y;
+      float blur       = max(vShape.z, aa);
+      shadow = vec4(vShadowColor.rgb, vShadowColor.a * (1.0f - smoothstep(-blur, blur, shadowDist)));
+   }
+
+   // The body over its shadow.
+   float alpha = body.a + shadow.a * (1.0f - body.a);
+   if (alpha <= 0.0f) {
+      discard;
+   }
+   vec3 color = (body.rgb * body.a + shadow.rgb * shadow.a * (1.0f - body.a)) / alpha;
+   fragColor = vec4(color, alpha);
+}
+
 void main() {
+   // Outside of the switch, derivatives need uniform control flow.
+   vec2 uvWidth = fwidth(vTexCoord);
+
    vFragColor = vec4(1.0f, 0.0f, 1.0f, 1.0f);
    switch (vEffectMode) {
       case 0u: {
-         vFragColor = vColor * getTextureColor();
+         if (vTexIndex == SOLID) {
+            vFragColor = vColor;
+         } else {
+            vFragColor = vColor * getTextureColor();
+         }
       } break;
       case 1u: {
          effect_striped(vFragColor);
@@ -136,5 +252,11 @@ void main() {
       case 3u: {
         effect_roundedCorners(vFragColor);
       } break;
+      case 4u: {
+        effect_shape(uvWidth, vFragColor);
+      } break;
+      case 5u: {
+        vFragColor = vColor * getTextColor(uvWidth);
+      } break;
    }
 }
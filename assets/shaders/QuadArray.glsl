@@ -0,0 +1,37 @@
+@type vertex
+
+layout (location = 0) in vec2 aPosition;
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in uint aTexIndex;
+layout (location = 4) in uint aEffectMode;
+layout (location = 5) in vec2 aQuadSize;
+
+out vec4 vColor;
+out vec2 vTexCoord;
+flat out uint vLayer;
+
+void main() {
+   vColor      = aColor;
+   vTexCoord   = aTexCoord;
+   vLayer      = aTexIndex;
+   gl_Position = vec4(aPosition, 0.0f, 1.0f);
+}
+
+@type fragment
+
+precision mediump float;
+precision mediump sampler2DArray;
+
+out vec4 vFragColor;
+
+in vec4 vColor;
+in vec2 vTexCoord;
+flat in uint vLayer;
+
+// Same vertex layout as Quad.glsl, the texture index is the layer.
+uniform sampler2DArray uImages;
+
+void main() {
+   vFragColor = vColor * texture(uImages, vec3(vTexCoord, float(vLayer)));
+}
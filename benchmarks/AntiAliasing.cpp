@@ -0,0 +1,60 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+#include <Renderer/FrameBuffer.hpp>
+
+#include <string>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// The same frame with shader anti-aliasing and with 2x, 4x and 8x MSAA. The
+// multisampled frames are resolved into a single sampled target, as the
+// window system does before presenting. Framebuffer memory is reported per
+// mode.
+
+TEST_CASE("Frames with shader anti-aliasing vs MSAA", "[benchmark][frame][antialiasing]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+
+  auto tree = createWideTree(100, 100);
+  auto resolved = FrameBuffer::builder(WIDTH, HEIGHT)
+    .attach(FrameBuffer::Attachment::Type::Texture, FrameBuffer::Attachment::Format::Rgba8)
+    .build();
+
+  for (auto mode : {AntiAliasing::None, AntiAliasing::Msaa2, AntiAliasing::Msaa4, AntiAliasing::Msaa8}) {
+    const u32 samples = (u32)mode;
+
+    auto target = resolved;
+    if (samples != 0) {
+      target = FrameBuffer::builder(WIDTH, HEIGHT)
+        .attach(FrameBuffer::Attachment::Type::RenderBuffer, FrameBuffer::Attachment::Format::Rgba8)
+        .samples(samples)
+        .build();
+    }
+    renderer.setAntiAliasing(mode);
+
+    const std::string name = samples == 0 ? "shader AA" : std::to_string(samples) + "x MSAA";
+    WARN(name << ": " << target->getByteSize() / 1024 << " KiB of framebuffer memory");
+
+    BENCHMARK("frame, wide tree 100x100, " + name) {
+      target->bind();
+      renderer.begin(context.getCamera());
+      renderer.clearScreen();
+
+      tree->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+      tree->draw(renderer);
+
+      renderer.end();
+      if (samples != 0) {
+        target->resolve(resolved->getId());
+      }
+      target->unbind();
+      glFinish();
+    };
+  }
+
+  renderer.setAntiAliasing(AntiAliasing::None);
+}
@@ -0,0 +1,123 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <iterator>
+
+#include "Common.hpp"
+#include "AllocationTracker.hpp"
+
+#include <Events/FileDropEvent.hpp>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+using Gui::Tests::AllocationStats;
+using Gui::Tests::AllocationTracker;
+
+namespace {
+
+  template<typename T>
+  using HeapVector = std::vector<T>;
+
+  struct DrawCommand {
+    Vec2 position;
+    Vec2 size;
+    Vec4 color;
+  };
+
+  // Transient work of a frame: per container scratch constraints and a
+  // draw list for the whole frame.
+  template<template<typename> typename Vector>
+  usize simulateFrame(u32 containers, u32 children) {
+    Vector<DrawCommand> commands;
+    for (u32 i = 0; i < containers; ++i) {
+      Vector<Constraints> constraints;
+      for (u32 j = 0; j < children; ++j) {
+        constraints.push_back(Constraints(0.0f, 0.0f, (f32)WIDTH / (f32)children, (f32)HEIGHT));
+      }
+      for (auto& constraint : constraints) {
+        commands.push_back({{0.0f, 0.0f}, {constraint.maxWidth, constraint.maxHeight}, Color::WHITE});
+      }
+    }
+    return commands.size();
+  }
+
+  static const char* DROPPED_PATHS[] = {
+    "/home/user/Documents/projects/libgui/assets/textures/image-01.png",
+    "/home/user/Documents/projects/libgui/assets/textures/image-02.png",
+    "/home/user/Documents/projects/libgui/assets/textures/image-03.png",
+    "/home/user/Documents/projects/libgui/assets/textures/image-04.png",
+    "/home/user/Documents/projects/libgui/assets/textures/image-05.png",
+    "/home/user/Documents/projects/libgui/assets/textures/image-06.png",
+    "/home/user/Documents/projects/libgui/assets/textures/image-07.png",
+    "/home/user/Documents/projects/libgui/assets/textures/image-08.png",
+  };
+
+  usize buildDroppedPathsOnHeap() {
+    std::vector<String> paths;
+    for (auto path : DROPPED_PATHS) {
+      paths.emplace_back(path);
+    }
+    return paths.size();
+  }
+
+  usize buildDroppedPathsInArena() {
+    auto& arena = FrameArena::get();
+    FileDropEvent::Paths paths(arena);
+    paths.reserve(std::size(DROPPED_PATHS));
+    for (auto path : DROPPED_PATHS) {
+      const usize length = std::strlen(path);
+      char* copy = arena.allocate<char>(length);
+      std::memcpy(copy, path, length);
+      paths.emplace_back(copy, length);
+    }
+    FileDropEvent event(std::move(paths));
+    return event.getPaths().size();
+  }
+
+  template<typename F>
+  AllocationStats countAllocations(F frame) {
+    // Warm up, so the arena has grown to its steady-state size.
+    frame();
+    FrameArena::get().reset();
+
+    AllocationTracker::start();
+    frame();
+    auto stats = AllocationTracker::stop();
+    FrameArena::get().reset();
+    return stats;
+  }
+
+} // namespace
+
+TEST_CASE("Transient frame data, std::allocator vs frame arena", "[benchmark][arena]") {
+  auto heap  = countAllocations([] { return simulateFrame<HeapVector>(100, 10); });
+  auto arena = countAllocations([] { return simulateFrame<FrameVector>(100, 10); });
+  WARN("allocations per frame, 100 containers x 10 children: std::allocator " << heap.count << ", frame arena " << arena.count);
+  CHECK(arena.count == 0);
+
+  BENCHMARK("std::allocator, 100 containers x 10 children") {
+    return simulateFrame<HeapVector>(100, 10);
+  };
+
+  BENCHMARK("frame arena, 100 containers x 10 children") {
+    FrameArena::get().reset();
+    return simulateFrame<FrameVector>(100, 10);
+  };
+}
+
+TEST_CASE("File drop payload, std::allocator vs frame arena", "[benchmark][arena]") {
+  auto heap  = countAllocations(buildDroppedPathsOnHeap);
+  auto arena = countAllocations(buildDroppedPathsInArena);
+  WARN("allocations per drop of 8 paths: std::allocator " << heap.count << ", frame arena " << arena.count);
+  CHECK(arena.count == 0);
+
+  BENCHMARK("std::vector<String>, 8 paths") {
+    return buildDroppedPathsOnHeap();
+  };
+
+  BENCHMARK("FileDropEvent::Paths in frame arena, 8 paths") {
+    FrameArena::get().reset();
+    return buildDroppedPathsInArena();
+  };
+}
@@ -0,0 +1,117 @@
+#include "Common.hpp"
+
+namespace Gui::Benchmarks {
+
+  static constexpr Vec4 COLORS[] = {
+    rgba(0x00688BFF),
+    rgba(0x03A89EFF),
+    rgba(0xCD3700FF),
+    rgba(0xFF6103FF),
+  };
+
+  Context& Context::get() {
+    static Context context;
+    return context;
+  }
+
+  Context::Context()
+    : mWindow{Window::create("LibGUI - Benchmarks", WIDTH, HEIGHT, false)},
+      mCamera(WIDTH, HEIGHT, (f32)WIDTH / (f32)HEIGHT)
+  {
+    GUI_ASSERT_WITH_MESSAGE(mWindow, "benchmarks need an OpenGL context");
+    mWindow->setVSync(false);
+    mCamera.resize(WIDTH, HEIGHT);
+    mRenderer = std::make_unique<Renderer2D>(WIDTH, HEIGHT);
+    mRenderer->blending(true);
+  }
+
+  Widget::Handle createDeepTree(u32 depth) {
+    Container::Handle root = Column::create();
+    root->setColor(COLORS[0]);
+
+    Container* current = root.get();
+    for (u32 i = 1; i < depth; ++i) {
+      Container::Handle child;
+      if (i % 2 == 0) {
+        child = Column::create();
+      } else {
+        child = Row::create();
+      }
+      child->setColor(COLORS[i % 4]);
+      child->setPadding(Vec4{1.0f});
+      current->addChild(child);
+      current = child.get();
+    }
+    current->addChild(Label::create("leaf", 12));
+    return root;
+  }
+
+  Widget::Handle createWideTree(u32 rows, u32 columns) {
+    auto root = Row::create();
+    root->setColor(COLORS[0]);
+    for (u32 i = 0; i < rows; ++i) {
+      auto row = Column::create();
+      row->setColor(COLORS[i % 4]);
+      for (u32 j = 0; j < columns; ++j) {
+        switch ((i + j) % 3) {
+          case 0: {
+            auto box = SizedBox::create(8.0f, 8.0f);
+            box->setColor(COLORS[j % 4]);
+            row->addChild(box);
+          } break;
+          case 1:
+            row->addChild(Label::create("cell", 8));
+            break;
+          case 2: {
+            auto button = Button::create([](auto) { return true; }, "ok", 8);
+            button->setBackground(COLORS[j % 4]);
+            row->addChild(button);
+          } break;
+        }
+      }
+      root->addChild(row);
+    }
+    return root;
+  }
+
+  std::string createYamlDocument(u32 rows, u32 columns) {
+    std::string result;
+    result += "row:\n";
+    result += "  color: 0x040D12\n";
+    result += "  children:\n";
+    for (u32 i = 0; i < rows; ++i) {
+      result += "    column:\n";
+      result += "      id: row-" + std::to_string(i) + "\n";
+      result += "      padding: 2\n";
+      result += "      children:\n";
+      for (u32 j = 0; j < columns; ++j) {
+        switch ((i + j) % 4) {
+          case 0:
+            result += "        label:\n";
+            result += "          text: \"Label " + std::to_string(j) + "\"\n";
+            result += "          color: 0xfed766\n";
+            break;
+          case 1:
+            result += "        button:\n";
+            result += "          text: Submit\n";
+            result += "          background: 0x93B1A6\n";
+            result += "          margin: 2\n";
+            break;
+          case 2:
+            result += "        checkbox:\n";
+            result += "          width: 20\n";
+            result += "          height: 20\n";
+            break;
+          case 3:
+            result += "        sized-box:\n";
+            result += "          width: 10\n";
+            result += "          height: 10\n";
+            result += "          color: red\n";
+            break;
+        }
+      }
+    }
+    return result;
+  }
+
+} // namespace Gui::Benchmarks
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Gui.hpp>
+
+#include <memory>
+#include <string>
+
+namespace Gui::Benchmarks {
+
+  static constexpr const u32 WIDTH  = 1280;
+  static constexpr const u32 HEIGHT = 720;
+
+  // Hidden window that provides the OpenGL context, plus a renderer and a
+  // camera matching the window size. Created once and shared by every
+  // benchmark that needs to talk to the GPU.
+  class Context {
+  public:
+    static Context& get();
+    DISALLOW_MOVE_AND_COPY(Context);
+
+    inline Renderer2D& getRenderer() { return *mRenderer; }
+    inline const Camera& getCamera() const { return mCamera.getCamera(); }
+
+  private:
+    Context();
+
+  private:
+    Window::Handle mWindow;
+    OrthographicCameraController mCamera;
+    std::unique_ptr<Renderer2D> mRenderer;
+  };
+
+  // Single chain of alternating columns and rows, `depth` levels deep.
+  Widget::Handle createDeepTree(u32 depth);
+
+  // Row of `rows` columns, each containing `columns` leaf widgets.
+  Widget::Handle createWideTree(u32 rows, u32 columns);
+
+  // YAML document describing a row of `rows` columns with `columns` widgets
+  // each, cycling through the different widget kinds.
+  std::string createYamlDocument(u32 rows, u32 columns);
+
+} // namespace Gui::Benchmarks
@@ -0,0 +1,28 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+TEST_CASE("Widget deserialization", "[benchmark][deserialize]") {
+  const auto small = YAML::Load(createYamlDocument(10, 10));
+  const auto large = YAML::Load(createYamlDocument(100, 100));
+
+  BENCHMARK("Widget::deserialize, 100 widgets") {
+    std::vector<DeserializationError> errors;
+    return Widget::deserialize(small, errors);
+  };
+
+  BENCHMARK("Widget::deserialize, 10k widgets") {
+    std::vector<DeserializationError> errors;
+    return Widget::deserialize(large, errors);
+  };
+
+  const auto source = createYamlDocument(100, 100);
+  BENCHMARK("YAML::Load + Widget::deserialize, 10k widgets") {
+    std::vector<DeserializationError> errors;
+    return Widget::deserialize(YAML::Load(source), errors);
+  };
+}
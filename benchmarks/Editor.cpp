@@ -0,0 +1,52 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <Core/Editor.hpp>
+#include <Core/Type.hpp>
+
+using namespace Gui;
+
+static std::string createBuffer(usize lines, usize lineLength) {
+  std::string result;
+  result.reserve(lines * (lineLength + 1));
+  for (usize i = 0; i < lines; ++i) {
+    result.append(lineLength, (char)('a' + i % 26));
+    result += '\n';
+  }
+  return result;
+}
+
+// Every line is a single word, so this is linear in the line count instead of
+// quadratic like repeated moveLineDown calls.
+static void moveToLine(Editor& editor, usize line) {
+  for (usize i = 0; i < line; ++i) {
+    editor.moveWordRight();
+  }
+}
+
+TEST_CASE("Editor operations on large buffers", "[benchmark][editor]") {
+  const auto buffer = createBuffer(10'000, 80);
+
+  BENCHMARK_ADVANCED("insertChar in the middle of 810KB")(Catch::Benchmark::Chronometer meter) {
+    Editor editor(buffer);
+    moveToLine(editor, 5'000);
+    meter.measure([&] { editor.insertChar('x'); });
+  };
+
+  BENCHMARK_ADVANCED("backspace in the middle of 810KB")(Catch::Benchmark::Chronometer meter) {
+    Editor editor(buffer);
+    moveToLine(editor, 5'000);
+    meter.measure([&] { editor.backspace(); });
+  };
+
+  BENCHMARK_ADVANCED("deleteChar at the start of 810KB")(Catch::Benchmark::Chronometer meter) {
+    Editor editor(buffer);
+    meter.measure([&] { editor.deleteChar(); });
+  };
+
+  BENCHMARK_ADVANCED("cursorRow at the end of 810KB")(Catch::Benchmark::Chronometer meter) {
+    Editor editor(buffer);
+    moveToLine(editor, 10'000);
+    meter.measure([&] { return editor.cursorRow(); });
+  };
+}
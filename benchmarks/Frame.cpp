@@ -0,0 +1,52 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+#include <Renderer/FrameBuffer.hpp>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// Layout, draw and glFinish of a complete widget tree into an offscreen
+// framebuffer, same as Application::logicLoop minus the buffer swap.
+static void renderFrame(Renderer2D& renderer, const Camera& camera, FrameBuffer& target, const Widget::Handle& root) {
+  target.bind();
+  renderer.begin(camera);
+  renderer.clearScreen();
+
+  root->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+  root->draw(renderer);
+
+  renderer.end();
+  target.unbind();
+  glFinish();
+}
+
+TEST_CASE("Full frames rendered offscreen", "[benchmark][frame]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+
+  auto target = FrameBuffer::builder(WIDTH, HEIGHT)
+    .attach(FrameBuffer::Attachment::Type::Texture, FrameBuffer::Attachment::Format::Rgba8)
+    .build();
+
+  auto wide = createWideTree(100, 100);
+  auto deep = createDeepTree(12);
+
+  std::vector<DeserializationError> errors;
+  auto form = Widget::deserialize(YAML::Load(createYamlDocument(20, 20)), errors);
+  REQUIRE(errors.empty());
+
+  BENCHMARK("frame, wide tree 100x100") {
+    renderFrame(renderer, context.getCamera(), *target, wide);
+  };
+
+  BENCHMARK("frame, deep tree depth=12") {
+    renderFrame(renderer, context.getCamera(), *target, deep);
+  };
+
+  BENCHMARK("frame, deserialized 20x20 form") {
+    renderFrame(renderer, context.getCamera(), *target, form);
+  };
+}
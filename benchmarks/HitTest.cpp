@@ -0,0 +1,100 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// Mirrors the lookups Application does on every mouse click: the first
+// focusable widget under the cursor, then every widget with a click handler.
+static usize hitTest(const Widget::Handle& root, Vec2 point) {
+  Widget::Handle focused = nullptr;
+  usize clickable = 0;
+
+  Widget::Visitor focusVisitor = [&](const Widget::Handle& current) {
+    if (current->isFocusable() && current->contains(point)) {
+      focused = current;
+      return false;
+    }
+    return true;
+  };
+  root->visit(root, focusVisitor);
+
+  Widget::Visitor clickVisitor = [&](const Widget::Handle& current) {
+    if (current->contains(point) && current->hasClickEventHandler()) {
+      clickable++;
+    }
+    return true;
+  };
+  root->visit(root, clickVisitor);
+
+  return clickable + (focused ? 1 : 0);
+}
+
+TEST_CASE("Hit-testing", "[benchmark][hit-test]") {
+  auto tree = createWideTree(100, 100);
+  tree->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+
+  BENCHMARK("hit-test center, 10k widgets") {
+    return hitTest(tree, {WIDTH / 2.0f, HEIGHT / 2.0f});
+  };
+
+  BENCHMARK("hit-test bottom-right corner, 10k widgets") {
+    return hitTest(tree, {WIDTH - 1.0f, HEIGHT - 1.0f});
+  };
+
+  BENCHMARK("hit-test outside, 10k widgets") {
+    return hitTest(tree, {-1.0f, -1.0f});
+  };
+}
+
+// Same lookups as hitTest(), as linear scans over a WidgetTree snapshot.
+static usize hitTestFlat(const WidgetTree& tree, Vec2 point) {
+  const auto focused = tree.findAt(point, WidgetTree::Visible | WidgetTree::Focusable);
+
+  usize clickable = 0;
+  const u8 flags = WidgetTree::Visible | WidgetTree::Clickable;
+  for (auto id = tree.findAt(point, flags); id != WidgetTree::NONE; id = tree.findAt(point, flags, id + 1)) {
+    clickable++;
+  }
+
+  return clickable + (focused != WidgetTree::NONE ? 1 : 0);
+}
+
+TEST_CASE("Hit-testing a WidgetTree snapshot", "[benchmark][hit-test]") {
+  auto root = createWideTree(100, 100);
+  root->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+
+  WidgetTree tree;
+  tree.rebuild(root);
+
+  for (auto point : {Vec2{WIDTH / 2.0f, HEIGHT / 2.0f}, Vec2{WIDTH - 1.0f, HEIGHT - 1.0f}, Vec2{-1.0f, -1.0f}}) {
+    REQUIRE(hitTest(root, point) == hitTestFlat(tree, point));
+  }
+
+  BENCHMARK("rebuild snapshot, 10k widgets") {
+    tree.rebuild(root);
+    return tree.size();
+  };
+
+  BENCHMARK("hit-test center, 10k widgets") {
+    return hitTestFlat(tree, {WIDTH / 2.0f, HEIGHT / 2.0f});
+  };
+
+  BENCHMARK("hit-test bottom-right corner, 10k widgets") {
+    return hitTestFlat(tree, {WIDTH - 1.0f, HEIGHT - 1.0f});
+  };
+
+  BENCHMARK("hit-test outside, 10k widgets") {
+    return hitTestFlat(tree, {-1.0f, -1.0f});
+  };
+
+  std::vector<WidgetTree::Id> visible;
+  visible.reserve(tree.size());
+  BENCHMARK("collect visible in top-left quarter, 10k widgets") {
+    visible.clear();
+    tree.collectVisible({0.0f, 0.0f}, {WIDTH / 2.0f, HEIGHT / 2.0f}, visible);
+    return visible.size();
+  };
+}
@@ -0,0 +1,113 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+#include <Renderer/TextureArray.hpp>
+#include <Renderer/DynamicAtlas.hpp>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// Icon grid with more distinct images than a batch has texture slots: as
+// separate textures every 16 new images force a flush, as layers of one
+// TextureArray the whole grid is a single batch.
+
+namespace {
+
+  static constexpr const u32 IMAGE_COUNT = 64;
+  static constexpr const u32 IMAGE_SIZE  = 32;
+
+  std::vector<u32> createPixels(u32 seed, u32 size = IMAGE_SIZE) {
+    std::vector<u32> pixels(size * size);
+    for (u32 i = 0; i < pixels.size(); ++i) {
+      pixels[i] = 0xFF000000 | (seed * 0x9E3779B9u + i * 0x45D9F3Bu);
+    }
+    return pixels;
+  }
+
+  template<typename Draw>
+  void drawGrid(Renderer2D& renderer, const Camera& camera, Draw draw, u32 imageCount = IMAGE_COUNT) {
+    renderer.begin(camera);
+
+    const f32 cell = 12.0f;
+    const u32 columns = WIDTH / (u32)cell;
+    for (u32 i = 0; i < 10'000; ++i) {
+      const Vec2 position = {(f32)(i % columns) * cell, (f32)(i / columns) * cell};
+      draw(position, Vec2{cell, cell}, i % imageCount);
+    }
+
+    renderer.end();
+    glFinish();
+  }
+
+} // namespace
+
+TEST_CASE("Image grid with separate textures vs a TextureArray", "[benchmark][images]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+
+  std::vector<SubTexture> textures;
+  auto array = TextureArray::create(IMAGE_SIZE, IMAGE_SIZE, IMAGE_COUNT);
+  std::vector<TextureArray::Image> images;
+  for (u32 i = 0; i < IMAGE_COUNT; ++i) {
+    auto pixels = createPixels(i);
+    auto texture = Texture::buffer(pixels.data(), IMAGE_SIZE, IMAGE_SIZE, Texture::DataFormat::Rgba, Texture::DataType::UnsignedByte)
+      .mipmap(Texture::MipmapMode::None)
+      .build();
+    textures.emplace_back(texture);
+
+    auto image = array->add(pixels.data(), IMAGE_SIZE, IMAGE_SIZE);
+    REQUIRE(image);
+    images.push_back(*image);
+  }
+
+  BENCHMARK("10k quads, 64 textures") {
+    drawGrid(renderer, context.getCamera(), [&](const Vec2& position, const Vec2& size, u32 index) {
+      renderer.drawQuad(position, size, textures[index]);
+    });
+  };
+
+  BENCHMARK("10k quads, 64 layers of a TextureArray") {
+    drawGrid(renderer, context.getCamera(), [&](const Vec2& position, const Vec2& size, u32 index) {
+      renderer.drawImage(position, size, images[index]);
+    });
+  };
+}
+
+TEST_CASE("500 icons as separate textures vs a DynamicAtlas", "[benchmark][images][atlas]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+
+  const u32 iconCount = 500;
+  const u32 iconSize  = 24;
+
+  auto atlas = DynamicAtlas::create();
+  std::vector<SubTexture> textures;
+  std::vector<SubTexture> packed;
+  for (u32 i = 0; i < iconCount; ++i) {
+    auto pixels = createPixels(i, iconSize);
+    auto texture = Texture::buffer(pixels.data(), iconSize, iconSize, Texture::DataFormat::Rgba, Texture::DataType::UnsignedByte)
+      .mipmap(Texture::MipmapMode::None)
+      .build();
+    textures.emplace_back(texture);
+
+    auto icon = atlas->add(pixels.data(), iconSize, iconSize);
+    REQUIRE(icon);
+    packed.push_back(*icon);
+  }
+
+  WARN("atlas: " << iconCount << " icons in " << atlas->getPageCount() << " pages");
+
+  BENCHMARK("10k quads, 500 textures") {
+    drawGrid(renderer, context.getCamera(), [&](const Vec2& position, const Vec2& size, u32 index) {
+      renderer.drawQuad(position, size, textures[index]);
+    }, iconCount);
+  };
+
+  BENCHMARK("10k quads, 500 icons in a DynamicAtlas") {
+    drawGrid(renderer, context.getCamera(), [&](const Vec2& position, const Vec2& size, u32 index) {
+      renderer.drawQuad(position, size, packed[index]);
+    }, iconCount);
+  };
+}
@@ -0,0 +1,33 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+TEST_CASE("Layout of deep Column/Row trees", "[benchmark][layout]") {
+  auto depth12 = createDeepTree(12);
+  auto depth16 = createDeepTree(16);
+
+  BENCHMARK("deep tree, depth=12") {
+    return depth12->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+  };
+
+  BENCHMARK("deep tree, depth=16") {
+    return depth16->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+  };
+}
+
+TEST_CASE("Layout of wide Column/Row trees", "[benchmark][layout]") {
+  auto wide100 = createWideTree(10, 10);
+  auto wide10k = createWideTree(100, 100);
+
+  BENCHMARK("wide tree, 10x10") {
+    return wide100->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+  };
+
+  BENCHMARK("wide tree, 100x100") {
+    return wide10k->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+  };
+}
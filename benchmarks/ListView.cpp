@@ -0,0 +1,78 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+
+#include <string>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// A million row list scrolled a bit every frame and jumped around at random.
+// Only the rows in view have widgets, so a frame costs the same at any list
+// size, and scrolled rows reuse the widgets of the rows that left.
+
+namespace {
+
+  static constexpr const usize ROW_COUNT = 1'000'000;
+
+  struct Counts {
+    usize created  = 0;
+    usize recycled = 0;
+  };
+
+  ListView::Handle createList(Counts& counts) {
+    return ListView::create(ROW_COUNT, [&counts](usize index, Widget::Handle recycled) -> Widget::Handle {
+      auto text = "Row " + std::to_string(index);
+      if (recycled) {
+        counts.recycled++;
+        recycled->as<Label>()->setText(std::move(text));
+        return recycled;
+      }
+      counts.created++;
+      return Label::create(std::move(text), 16);
+    }, 24.0f);
+  }
+
+  void drawFrame(Renderer2D& renderer, const Camera& camera, const ListView::Handle& list) {
+    renderer.begin(camera);
+    renderer.clearScreen();
+    list->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+    list->draw(renderer);
+    renderer.end();
+    glFlush();
+  }
+
+} // namespace
+
+TEST_CASE("Scrolling a million row ListView", "[benchmark][listview]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+
+  Counts counts;
+  auto list = createList(counts);
+  drawFrame(renderer, context.getCamera(), list);
+  REQUIRE(list->getChildren().size() < 64);
+
+  BENCHMARK("frame, scrolling 10px") {
+    list->scrollBy(10.0);
+    drawFrame(renderer, context.getCamera(), list);
+  };
+
+  u64 state = 1;
+  BENCHMARK("frame, jumping to a random row") {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    list->scrollToIndex((usize)(state >> 33) % ROW_COUNT);
+    drawFrame(renderer, context.getCamera(), list);
+  };
+
+  list->setEstimatedItemHeight(24.0f);
+  BENCHMARK("frame, jumping to a random row, estimated heights") {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    list->scrollToIndex((usize)(state >> 33) % ROW_COUNT);
+    drawFrame(renderer, context.getCamera(), list);
+  };
+
+  WARN(counts.created << " row widgets created, " << counts.recycled << " rows bound to recycled widgets");
+}
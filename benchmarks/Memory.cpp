@@ -0,0 +1,69 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include "AllocationTracker.hpp"
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+using Gui::Tests::AllocationStats;
+using Gui::Tests::AllocationTracker;
+
+// Memory footprint of each widget kind: the object itself, plus everything
+// its creation allocates (control block, text, handlers, ...). Run with the
+// "[memory]" tag and -s to see the numbers.
+
+namespace {
+
+  template<typename Create>
+  void reportFootprint(const char* name, usize size, Create create) {
+    AllocationTracker::start();
+    auto widget = create();
+    AllocationStats stats = AllocationTracker::stop();
+
+    WARN(name << ": sizeof " << size << " bytes, " << stats.bytes << " bytes in " << stats.count << " allocations per widget");
+  }
+
+} // namespace
+
+TEST_CASE("Memory footprint per widget", "[benchmark][memory]") {
+  // The font atlas is created on first use, don't count it.
+  Context::get();
+  Label::create("warmup", 12);
+
+  reportFootprint("SizedBox", sizeof(SizedBox), [] { return SizedBox::create(8.0f, 8.0f); });
+  reportFootprint("Label",    sizeof(Label),    [] { return Label::create("cell", 12); });
+  reportFootprint("Button",   sizeof(Button),   [] { return Button::create([](auto) { return true; }, "ok", 12); });
+  reportFootprint("CheckBox", sizeof(CheckBox), [] { return CheckBox::create([](auto) {}); });
+  reportFootprint("Input",    sizeof(Input),    [] { return Input::create([](auto) {}, "", 12); });
+  reportFootprint("TextArea", sizeof(TextArea), [] { return TextArea::create([](auto) {}, "", 12); });
+  reportFootprint("Row",      sizeof(Row),      [] { return Row::create(); });
+  reportFootprint("Column",   sizeof(Column),   [] { return Column::create(); });
+
+  // Ids are interned, every widget sharing an id costs 4 bytes for it.
+  reportFootprint("SizedBox with id", sizeof(SizedBox), [] {
+    auto box = SizedBox::create(8.0f, 8.0f);
+    box->setId("cell");
+    return box;
+  });
+
+  // 250 rows x 200 widgets = 50k leaves.
+  const auto document = YAML::Load(createYamlDocument(250, 200));
+  std::vector<DeserializationError> errors;
+
+  AllocationTracker::start();
+  auto tree = Widget::deserialize(document, errors);
+  AllocationStats stats = AllocationTracker::stop();
+  REQUIRE(errors.empty());
+
+  WARN("50k widget document: " << stats.bytes / 1024 << " KiB in " << stats.count << " allocations");
+
+  BENCHMARK("create 10k SizedBox") {
+    std::vector<Widget::Handle> widgets;
+    widgets.reserve(10'000);
+    for (u32 i = 0; i < 10'000; ++i) {
+      widgets.push_back(SizedBox::create(8.0f, 8.0f));
+    }
+    return widgets.size();
+  };
+}
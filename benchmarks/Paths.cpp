@@ -0,0 +1,102 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// A chart: a filled area under a series and the series stroked on top. Each
+// iteration is one frame. Rebuilding the path every frame tessellates it every
+// frame, keeping it reuses the cached triangles. Long series go through the
+// instanced polyline instead.
+
+namespace {
+
+  std::vector<Vec2> createSeries(u32 count) {
+    std::vector<Vec2> points(count);
+    for (u32 i = 0; i < count; ++i) {
+      const f32 x = (f32)i / (f32)(count - 1);
+      points[i] = Vec2{x * WIDTH, HEIGHT / 2.0f + std::sin(x * 40.0f) * HEIGHT / 4.0f + std::sin(x * 300.0f) * 20.0f};
+    }
+    return points;
+  }
+
+  Path createChart(const std::vector<Vec2>& series) {
+    Path path;
+    path.moveTo(series.front());
+    for (usize i = 1; i < series.size(); i += 2) {
+      // Every other point is a control point, so the benchmark covers curves.
+      const Vec2 point = i + 1 < series.size() ? series[i + 1] : series[i];
+      path.quadraticTo(series[i], point);
+    }
+    return path;
+  }
+
+  void drawChart(Renderer2D& renderer, const Camera& camera, const Path& path) {
+    Path::Stroke stroke;
+    stroke.width = 3.0f;
+    stroke.join = Path::Join::Round;
+    stroke.cap = Path::Cap::Round;
+
+    renderer.begin(camera);
+    renderer.drawPath(path, stroke, Color::BLUE);
+    renderer.end();
+    glFlush();
+  }
+
+} // namespace
+
+TEST_CASE("Path tessellation every frame vs cached", "[benchmark][paths]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+  renderer.blending(true);
+
+  const auto series = createSeries(2000);
+  const auto cached = createChart(series);
+
+  BENCHMARK("2000 point curve, tessellated every frame") {
+    drawChart(renderer, context.getCamera(), createChart(series));
+  };
+
+  BENCHMARK("2000 point curve, cached tessellation") {
+    drawChart(renderer, context.getCamera(), cached);
+  };
+
+  Path area = createChart(series);
+  area.lineTo(Vec2{(f32)WIDTH, (f32)HEIGHT}).lineTo(Vec2{0.0f, (f32)HEIGHT}).close();
+  BENCHMARK("2000 point filled area, cached tessellation") {
+    renderer.begin(context.getCamera());
+    renderer.fillPath(area, Color::GREEN);
+    renderer.end();
+    glFlush();
+  };
+}
+
+TEST_CASE("Long polylines as quads vs instanced segments", "[benchmark][paths]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+  renderer.blending(true);
+
+  const auto series = createSeries(100'000);
+
+  BENCHMARK("100k point polyline, a quad per point") {
+    renderer.begin(context.getCamera());
+    for (const auto& point : series) {
+      renderer.drawCenteredQuad(point, Vec2{2.0f, 2.0f}, Color::BLUE);
+    }
+    renderer.end();
+    glFlush();
+  };
+
+  BENCHMARK("100k point polyline, instanced segments") {
+    renderer.begin(context.getCamera());
+    renderer.drawPolyline({series.data(), series.size()}, 2.0f, Color::BLUE);
+    renderer.end();
+    glFlush();
+  };
+}
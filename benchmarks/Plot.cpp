@@ -0,0 +1,96 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// A telemetry plot holding a million samples per series. Each iteration is
+// one frame at 60 Hz: the samples that arrived since the last frame are
+// pushed, then the plot is drawn. The cost of a frame should not depend on how
+// many samples the view covers.
+
+namespace {
+
+  static constexpr const u32 SAMPLES_PER_FRAME = 16 * 1024;
+
+  f32 sample(u64 index) {
+    return std::sin((f32)index * 0.001f) + std::sin((f32)index * 0.37f) * 0.1f;
+  }
+
+  void drawFrame(Renderer2D& renderer, const Camera& camera, const Plot::Handle& plot) {
+    renderer.begin(camera);
+    plot->draw(renderer);
+    renderer.end();
+    glFlush();
+  }
+
+} // namespace
+
+TEST_CASE("Plot decimation matches a scan of the samples", "[benchmark][plot]") {
+  Plot::Series series(4096, Color::GREEN);
+  for (u64 i = 0; i < 10000; ++i) {
+    series.push(sample(i));
+  }
+
+  std::vector<Plot::Series::Column> columns;
+  series.decimate((f64)series.getBegin(), (f64)series.getEnd(), 100, columns);
+  REQUIRE(!columns.empty());
+
+  for (usize i = 0; i < columns.size(); ++i) {
+    const u64 first = std::max((u64)columns[i].x, series.getBegin());
+    const u64 last  = i + 1 < columns.size() ? (u64)columns[i + 1].x : series.getEnd();
+
+    f32 min = sample(first), max = sample(first);
+    for (u64 j = first; j < last; ++j) {
+      min = std::min(min, sample(j));
+      max = std::max(max, sample(j));
+    }
+    REQUIRE(columns[i].range.min <= min);
+    REQUIRE(columns[i].range.max >= max);
+  }
+}
+
+TEST_CASE("Plot of streaming series at different zoom levels", "[benchmark][plot]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+  renderer.blending(true);
+
+  auto plot = Plot::create((f32)WIDTH, (f32)HEIGHT);
+  plot->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+  auto& series = plot->addSeries(Color::GREEN);
+
+  u64 index = 0;
+  std::vector<f32> incoming(SAMPLES_PER_FRAME);
+  auto receive = [&] {
+    for (auto& value : incoming) {
+      value = sample(index++);
+    }
+    series.push({incoming.data(), incoming.size()});
+  };
+
+  while (index < series.getCapacity()) {
+    receive();
+  }
+
+  for (u64 window : {1'000ull, 100'000ull, 1'000'000ull}) {
+    plot->follow(window);
+    BENCHMARK("frame, 16k new samples, following the latest " + std::to_string(window)) {
+      receive();
+      drawFrame(renderer, context.getCamera(), plot);
+    };
+  }
+
+  plot->setView((f64)series.getBegin(), (f64)series.getEnd());
+  BENCHMARK("frame, zooming in on a million samples") {
+    plot->zoom(1.01);
+    drawFrame(renderer, context.getCamera(), plot);
+  };
+}
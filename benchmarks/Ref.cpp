@@ -0,0 +1,89 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+
+#include "Common.hpp"
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// Cost of handle copies on the draw path: std::shared_ptr against the
+// intrusive Ref used by the GPU resources, and a by-value visitor against the
+// borrowing Widget::Visitor. The end-to-end effect shows up in the "[frame]"
+// benchmarks, compare their JSON reports between two runs.
+
+namespace {
+
+  struct Resource : RefCounted {
+    u32 id;
+
+    Resource(u32 id)
+      : id{id}
+    {}
+  };
+
+  // One quad: look the texture up (a handle copy, like the old SubTexture),
+  // then find its batch slot by comparing handles.
+  template<typename Handle>
+  u32 batchQuads(const std::array<Handle, 16>& slots, const std::vector<Handle>& quads) {
+    u32 total = 0;
+    for (const auto& quad : quads) {
+      Handle texture = quad;
+      for (u32 i = 0; i < slots.size(); ++i) {
+        if (slots[i] == texture) {
+          total += i;
+          break;
+        }
+      }
+    }
+    return total;
+  }
+
+  template<typename Handle, typename Make>
+  void benchmarkHandles(const char* name, Make make) {
+    std::array<Handle, 16> slots;
+    for (u32 i = 0; i < slots.size(); ++i) {
+      slots[i] = make(i);
+    }
+
+    std::vector<Handle> quads;
+    for (u32 i = 0; i < 100'000; ++i) {
+      quads.push_back(slots[(i * 7) % slots.size()]);
+    }
+
+    BENCHMARK(name) {
+      return batchQuads(slots, quads);
+    };
+  }
+
+  u32 visitByValue(Widget::Handle widget, const std::function<bool(Widget::Handle)>& visitor) {
+    u32 count = 0;
+    for (Widget::Handle child : widget->getChildren()) {
+      count += visitByValue(child, visitor);
+    }
+    return count + (visitor(widget) ? 1 : 0);
+  }
+
+} // namespace
+
+TEST_CASE("Intrusive handles vs shared handles", "[benchmark][ref]") {
+  benchmarkHandles<std::shared_ptr<Resource>>("100k quads, std::shared_ptr handles", [](u32 i) { return std::make_shared<Resource>(i); });
+  benchmarkHandles<Ref<Resource>>("100k quads, Ref handles", [](u32 i) { return makeRef<Resource>(i); });
+
+  auto tree = createWideTree(100, 100);
+
+  BENCHMARK("visit wide tree 100x100, by value") {
+    return visitByValue(tree, [](Widget::Handle widget) { return widget->getDisplay(); });
+  };
+
+  BENCHMARK("visit wide tree 100x100, borrowed") {
+    u32 count = 0;
+    Widget::Visitor visitor = [&](const Widget::Handle& widget) {
+      count += widget->getDisplay() ? 1 : 0;
+      return true;
+    };
+    tree->visit(tree, visitor);
+    return count;
+  };
+}
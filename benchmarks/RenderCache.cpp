@@ -0,0 +1,86 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+
+#include <string>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// A panel of a thousand labels that doesn't change, drawn as usual and from
+// its cached render target. A cached panel that slides is drawn from the same
+// target, only the quad it is drawn with moves.
+
+namespace {
+
+  static constexpr const usize LABEL_COUNT = 1'000;
+
+  Column::Handle createPanel(Label::Handle first) {
+    auto panel = Column::create();
+    panel->setAlignment(Alignment::Vertical);
+    panel->setWidth(400.0f);
+    panel->setHeight((f32)HEIGHT);
+    panel->addChild(std::move(first));
+    for (usize i = 1; i < LABEL_COUNT; ++i) {
+      panel->addChild(Label::create("Item " + std::to_string(i), 12));
+    }
+    panel->layout({0.0f, 0.0f, 400.0f, (f32)HEIGHT});
+    return panel;
+  }
+
+  void drawFrame(Renderer2D& renderer, const Camera& camera, const Widget::Handle& panel) {
+    RenderCache::get().beginFrame();
+    renderer.begin(camera);
+    renderer.clearScreen();
+    panel->render(renderer);
+    renderer.end();
+    glFlush();
+  }
+
+} // namespace
+
+TEST_CASE("Drawing a static panel from its render target", "[benchmark][rendercache]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+  auto& cache = RenderCache::get();
+
+  auto label = Label::create("Item 0", 12);
+  auto panel = createPanel(label);
+
+  panel->setCacheMode(Widget::CacheMode::Never);
+  BENCHMARK("frame, uncached") {
+    drawFrame(renderer, context.getCamera(), panel);
+  };
+
+  panel->setCacheMode(Widget::CacheMode::Always);
+  REQUIRE(panel->isCached());
+  cache.resetStats();
+  BENCHMARK("frame, cached") {
+    drawFrame(renderer, context.getCamera(), panel);
+  };
+
+  // What a frame costs when something in the panel changes every frame.
+  u32 changes = 0;
+  BENCHMARK("frame, cached and changing") {
+    label->setText("Changed " + std::to_string(changes++));
+    drawFrame(renderer, context.getCamera(), panel);
+  };
+
+  Widget::Transform transform;
+  f32 t = 0.0f;
+  BENCHMARK("frame, cached and sliding") {
+    t = t >= 1.0f ? 0.0f : t + 1.0f / 60.0f;
+    transform.translation.x = -400.0f * (1.0f - t);
+    panel->setTransform(transform);
+    drawFrame(renderer, context.getCamera(), panel);
+  };
+
+  const auto& stats = cache.getStats();
+  WARN("render cache: " << stats.hits << " hits, " << stats.misses << " misses (" << stats.getHitRate() * 100.0f << "% hit rate), "
+    << stats.targets << " targets, " << stats.residentBytes / 1024 << " KiB");
+
+  panel->setCacheMode(Widget::CacheMode::Never);
+  REQUIRE_FALSE(panel->isCached());
+}
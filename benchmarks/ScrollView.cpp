@@ -0,0 +1,80 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+
+#include <string>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// A stack of ten thousand labels in a scroll view. Scrolling only changes the
+// translation the stack is drawn with, so a frame neither lays the stack out
+// again nor draws the labels out of view.
+//
+// The stack is centered without a height, like the rows of YAML documents, so
+// it would fill any space it is given. The view sizes it by its labels.
+
+namespace {
+
+  static constexpr const usize ROW_COUNT = 10'000;
+  static constexpr const f32 FONT_SIZE = 16.0f;
+
+  ScrollView::Handle createView() {
+    auto stack = Row::create();
+    stack->setAlignment(Alignment::Center);
+    for (usize i = 0; i < ROW_COUNT; ++i) {
+      stack->addChild(Label::create("Row " + std::to_string(i), FONT_SIZE));
+    }
+    return ScrollView::create(stack);
+  }
+
+  void layout(const ScrollView::Handle& view) {
+    view->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+  }
+
+  void drawFrame(Renderer2D& renderer, const Camera& camera, const ScrollView::Handle& view) {
+    renderer.begin(camera);
+    renderer.clearScreen();
+    view->draw(renderer);
+    renderer.end();
+    glFlush();
+  }
+
+} // namespace
+
+TEST_CASE("Scrolling a ScrollView of ten thousand labels", "[benchmark][scrollview]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+
+  auto view = createView();
+  layout(view);
+  REQUIRE(view->getContentSize().y == ROW_COUNT * FONT_SIZE);
+  REQUIRE(view->getMaxScroll().y == ROW_COUNT * FONT_SIZE - HEIGHT);
+
+  BENCHMARK("frame, scrolling 10px") {
+    if (!view->scrollBy({0.0f, 10.0f})) {
+      view->setScroll({0.0f, 0.0f});
+    }
+    drawFrame(renderer, context.getCamera(), view);
+  };
+
+  BENCHMARK("frame, gliding") {
+    if (!view->isAnimating()) {
+      view->setScroll({0.0f, 0.0f});
+      view->fling({0.0f, 4000.0f});
+    }
+    view->animate(1.0f / 60.0f);
+    drawFrame(renderer, context.getCamera(), view);
+  };
+
+  // What every scroll would cost if it moved the content by laying it out again.
+  BENCHMARK("frame, scrolling 10px with layout") {
+    if (!view->scrollBy({0.0f, 10.0f})) {
+      view->setScroll({0.0f, 0.0f});
+    }
+    layout(view);
+    drawFrame(renderer, context.getCamera(), view);
+  };
+}
@@ -0,0 +1,66 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+
+#include <vector>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// A 4K RGBA video frame replaced every frame, as a camera or remote desktop
+// view would. Each iteration is one frame: upload, draw, flush. At 60 Hz a
+// frame has 16.6ms, from client memory the upload waits for the GPU, through
+// the pixel buffer ring it overlaps with the previous frames.
+
+namespace {
+
+  static constexpr const u32 FRAME_WIDTH  = 3840;
+  static constexpr const u32 FRAME_HEIGHT = 2160;
+
+  void streamFrame(Renderer2D& renderer, const Camera& camera, const Texture::Handle& texture, std::vector<u32>& pixels, u32 frame) {
+    // Touch every row so the frame really is new.
+    for (u32 y = 0; y < FRAME_HEIGHT; ++y) {
+      pixels[y * FRAME_WIDTH + frame % FRAME_WIDTH] = 0xFF000000 | frame;
+    }
+    texture->update(Texture::Region{0, 0, FRAME_WIDTH, FRAME_HEIGHT}, pixels.data());
+
+    renderer.begin(camera);
+    renderer.drawQuad(Vec2{0.0f, 0.0f}, Vec2{(f32)WIDTH, (f32)HEIGHT}, texture);
+    renderer.end();
+    glFlush();
+  }
+
+  Texture::Handle createFrameTexture(bool streaming) {
+    return Texture::buffer(FRAME_WIDTH, FRAME_HEIGHT)
+      .mipmap(Texture::MipmapMode::None)
+      .streaming(streaming)
+      .build();
+  }
+
+} // namespace
+
+TEST_CASE("4K RGBA texture updates from client memory vs a PixelBufferRing", "[benchmark][images][streaming]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+
+  std::vector<u32> pixels(FRAME_WIDTH * FRAME_HEIGHT, 0xFF808080);
+
+  auto direct = createFrameTexture(false);
+  auto streamed = createFrameTexture(true);
+  REQUIRE(streamed->getPixelBuffers());
+
+  u32 frame = 0;
+  BENCHMARK("4K frame, glTexSubImage2D from client memory") {
+    streamFrame(renderer, context.getCamera(), direct, pixels, frame++);
+  };
+
+  BENCHMARK("4K frame, through a PixelBufferRing") {
+    streamFrame(renderer, context.getCamera(), streamed, pixels, frame++);
+  };
+  glFinish();
+
+  const auto& stats = streamed->getPixelBuffers()->getStats();
+  WARN("pixel buffer ring: " << stats.stalls << " of " << stats.writes << " writes waited for the GPU");
+}
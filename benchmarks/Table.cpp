@@ -0,0 +1,68 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+
+#include <cstdio>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// A 1M x 200 spreadsheet scrolled through its rows. Each iteration is one
+// frame. Only the cells in view are formatted, and those that stay in view
+// are taken from the cache, so scrolling by a few pixels formats almost
+// nothing while jumping formats a whole screen.
+
+namespace {
+
+  static constexpr const usize ROW_COUNT    = 1'000'000;
+  static constexpr const usize COLUMN_COUNT = 200;
+
+  void formatCell(usize row, usize column, String& out) {
+    char buffer[32];
+    const int length = std::snprintf(buffer, sizeof(buffer), "%.3f", (f64)(row * COLUMN_COUNT + column) * 0.125);
+    out.assign(buffer, (usize)length);
+  }
+
+  void drawFrame(Renderer2D& renderer, const Camera& camera, const Table::Handle& table) {
+    renderer.begin(camera);
+    table->layout({0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT});
+    table->draw(renderer);
+    renderer.end();
+    glFlush();
+  }
+
+} // namespace
+
+TEST_CASE("Scrolling a 1M row table", "[benchmark][table]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+
+  auto table = Table::create(ROW_COUNT, COLUMN_COUNT, formatCell);
+  table->setFrozenColumns(1);
+  drawFrame(renderer, context.getCamera(), table);
+
+  BENCHMARK("frame, scrolling 12px down") {
+    table->scrollBy(0.0, 12.0);
+    drawFrame(renderer, context.getCamera(), table);
+  };
+  WARN("scrolling: " << table->getStats().formatted << " cells formatted, " << table->getStats().cached << " cached in the last frame");
+
+  BENCHMARK("frame, scrolling 12px down and 8px right") {
+    table->scrollBy(8.0, 12.0);
+    drawFrame(renderer, context.getCamera(), table);
+  };
+
+  u64 state = 1;
+  BENCHMARK("frame, jumping to a random row") {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    table->scrollToCell((usize)(state >> 33) % ROW_COUNT, 0);
+    drawFrame(renderer, context.getCamera(), table);
+  };
+
+  BENCHMARK("frame, resizing a column") {
+    table->setColumnWidth(3, 64.0f + (f32)(state++ % 64));
+    drawFrame(renderer, context.getCamera(), table);
+  };
+}
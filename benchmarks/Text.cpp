@@ -0,0 +1,41 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+static std::string createText(usize glyphs, usize lineLength) {
+  std::string result;
+  result.reserve(glyphs);
+  for (usize i = 0; i < glyphs; ++i) {
+    if (i % lineLength == lineLength - 1) {
+      result += '\n';
+    } else {
+      result += (char)('!' + i % ('~' - '!'));
+    }
+  }
+  return result;
+}
+
+TEST_CASE("Text rendering", "[benchmark][renderer][text]") {
+  auto& context  = Context::get();
+  auto& renderer = context.getRenderer();
+
+  const auto text = createText(100'000, 160);
+
+  BENCHMARK("drawText, 100k glyphs") {
+    renderer.begin(context.getCamera());
+    renderer.drawText(text, {0.0f, 0.0f}, 8.0f, Color::BLACK);
+    renderer.end();
+  };
+
+  BENCHMARK("drawText, 100k glyphs + glFinish") {
+    renderer.begin(context.getCamera());
+    renderer.drawText(text, {0.0f, 0.0f}, 8.0f, Color::BLACK);
+    renderer.end();
+    glFinish();
+  };
+}
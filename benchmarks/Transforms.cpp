@@ -0,0 +1,75 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Common.hpp"
+#include <Core/OpenGL.hpp>
+
+#include <string>
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// A panel of a thousand labels sliding in and fading, animated through its
+// transform and opacity. Its layout is computed once and not touched again.
+
+namespace {
+
+  static constexpr const usize LABEL_COUNT = 1'000;
+
+  Column::Handle createPanel() {
+    auto panel = Column::create();
+    panel->setAlignment(Alignment::Vertical);
+    panel->setWidth(400.0f);
+    panel->setHeight((f32)HEIGHT);
+    for (usize i = 0; i < LABEL_COUNT; ++i) {
+      panel->addChild(Label::create("Item " + std::to_string(i), 12));
+    }
+    panel->layout({0.0f, 0.0f, 400.0f, (f32)HEIGHT});
+    return panel;
+  }
+
+  void drawFrame(Renderer2D& renderer, const Camera& camera, const Widget::Handle& panel) {
+    renderer.begin(camera);
+    renderer.clearScreen();
+    panel->render(renderer);
+    renderer.end();
+    glFlush();
+  }
+
+} // namespace
+
+TEST_CASE("Animating the transform of a panel", "[benchmark][transform]") {
+  auto& context = Context::get();
+  auto& renderer = context.getRenderer();
+
+  auto panel = createPanel();
+  Widget::Transform transform;
+
+  f32 t = 0.0f;
+  BENCHMARK("frame, sliding") {
+    t = t >= 1.0f ? 0.0f : t + 1.0f / 60.0f;
+    transform.translation.x = -400.0f * (1.0f - t);
+    panel->setTransform(transform);
+    drawFrame(renderer, context.getCamera(), panel);
+  };
+
+  BENCHMARK("frame, sliding and fading") {
+    t = t >= 1.0f ? 0.0f : t + 1.0f / 60.0f;
+    transform.translation.x = -400.0f * (1.0f - t);
+    panel->setTransform(transform);
+    panel->setOpacity(t);
+    drawFrame(renderer, context.getCamera(), panel);
+  };
+
+  BENCHMARK("frame, zooming in") {
+    t = t >= 1.0f ? 0.0f : t + 1.0f / 60.0f;
+    transform.translation.x = 0.0f;
+    transform.scale = Vec2{0.5f + 0.5f * t};
+    panel->setTransform(transform);
+    panel->setOpacity(1.0f);
+    drawFrame(renderer, context.getCamera(), panel);
+  };
+
+  panel->clearTransform();
+  REQUIRE(panel->getTransform() == nullptr);
+}
@@ -0,0 +1,92 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+#include "Common.hpp"
+
+using namespace Gui;
+using namespace Gui::Benchmarks;
+
+// Traversal and layout of a 50k widget tree, allocated on the heap or in a
+// WidgetArena. Run with `perf stat -e cache-misses,cache-references` and a
+// tag filter (e.g. "[widget-arena]") to see the cache-miss difference behind
+// the timings.
+
+namespace {
+
+  // Long running applications don't have a pristine heap: interleave the
+  // widget allocations with live blocks of other sizes, like an aged heap.
+  std::vector<std::unique_ptr<u8[]>> fragmentHeap() {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<usize> sizes(16, 512);
+
+    std::vector<std::unique_ptr<u8[]>> blocks;
+    for (usize i = 0; i < 200'000; ++i) {
+      blocks.emplace_back(new u8[sizes(rng)]);
+    }
+    for (usize i = 0; i < blocks.size(); i += 2) {
+      blocks[i].reset();
+    }
+    return blocks;
+  }
+
+  usize countWidgets(const Widget::Handle& root) {
+    usize count = 0;
+    Widget::Visitor visitor = [&](const Widget::Handle&) {
+      count++;
+      return true;
+    };
+    root->visit(root, visitor);
+    return count;
+  }
+
+} // namespace
+
+TEST_CASE("Widget tree in a WidgetArena vs on the heap", "[benchmark][widget-arena]") {
+  // 250 rows x 200 widgets = 50k leaves.
+  const auto document = YAML::Load(createYamlDocument(250, 200));
+  const Constraints constraints = {0.0f, 0.0f, (f32)WIDTH, (f32)HEIGHT};
+
+  auto fragmentation = fragmentHeap();
+
+  std::vector<DeserializationError> errors;
+  auto heapTree = Widget::deserialize(document, errors);
+
+  auto arena = WidgetArena::create();
+  auto arenaTree = Widget::deserialize(document, errors, arena);
+  REQUIRE(errors.empty());
+  REQUIRE(countWidgets(heapTree) == countWidgets(arenaTree));
+
+  WARN("arena: " << arena->getUsed() / 1024 << " KiB used in " << arena->getCapacity() / 1024 << " KiB of blocks");
+
+  BENCHMARK("traversal, heap, 50k widgets") {
+    return countWidgets(heapTree);
+  };
+
+  BENCHMARK("traversal, arena, 50k widgets") {
+    return countWidgets(arenaTree);
+  };
+
+  BENCHMARK("layout, heap, 50k widgets") {
+    return heapTree->layout(constraints);
+  };
+
+  BENCHMARK("layout, arena, 50k widgets") {
+    return arenaTree->layout(constraints);
+  };
+
+  BENCHMARK_ADVANCED("deserialize + destroy, heap, 50k widgets")(Catch::Benchmark::Chronometer meter) {
+    meter.measure([&] {
+      std::vector<DeserializationError> errors;
+      return Widget::deserialize(document, errors) != nullptr;
+    });
+  };
+
+  BENCHMARK_ADVANCED("deserialize + destroy, arena, 50k widgets")(Catch::Benchmark::Chronometer meter) {
+    meter.measure([&] {
+      std::vector<DeserializationError> errors;
+      return Widget::deserialize(document, errors, WidgetArena::create()) != nullptr;
+    });
+  };
+}
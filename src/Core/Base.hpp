@@ -4,5 +4,6 @@
 #include "Core/Log.hpp"
 #include "Core/Type.hpp"
 #include "Core/Color.hpp"
+#include "Core/Ref.hpp"
 
 #include <glm/gtc/matrix_transform.hpp>
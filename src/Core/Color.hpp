@@ -21,6 +21,7 @@ namespace Gui {
 
   class Color {
   public:
+    static constexpr const auto TRANSPARENT = rgba(0x00000000);
     static constexpr const auto WHITE     = rgba(0xFFFFFFFF);
     static constexpr const auto BLACK     = rgba(0x000000FF);
     static constexpr const auto DARK_GRAY = rgba(0xA9A9A9FF);
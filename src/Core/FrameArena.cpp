@@ -0,0 +1,93 @@
+#include "Core/Base.hpp"
+#include "Core/FrameArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace Gui {
+
+  FrameArena& FrameArena::get() {
+    static thread_local FrameArena arena;
+    return arena;
+  }
+
+  FrameArena::FrameArena(usize blockSize)
+    : mBlockSize{blockSize}
+  {
+    mBlocks.push_back({new u8[mBlockSize], mBlockSize});
+  }
+
+  FrameArena::~FrameArena() {
+    for (auto& block : mBlocks) {
+      delete[] block.data;
+    }
+  }
+
+  void* FrameArena::allocate(usize size, usize alignment) {
+    GUI_DEBUG_ASSERT((alignment & (alignment - 1)) == 0);
+
+    auto& block = mBlocks[mCurrent];
+    auto address = reinterpret_cast<uintptr_t>(block.data) + mOffset;
+    auto padding = (alignment - address % alignment) % alignment;
+    if (mOffset + padding + size > block.size) {
+      return allocateFromNextBlock(size, alignment);
+    }
+
+    mOffset += padding + size;
+    mUsed   += padding + size;
+    return block.data + mOffset - size;
+  }
+
+  void* FrameArena::allocateFromNextBlock(usize size, usize alignment) {
+    // The rest of the current block is wasted, it is reclaimed on reset.
+    mCurrent++;
+    mOffset = 0;
+
+    while (mCurrent < mBlocks.size() && mBlocks[mCurrent].size < size + alignment) {
+      mCurrent++;
+    }
+
+    if (mCurrent == mBlocks.size()) {
+      auto blockSize = std::max(mBlockSize, size + alignment);
+      mBlocks.push_back({new u8[blockSize], blockSize});
+    }
+
+    return allocate(size, alignment);
+  }
+
+  void FrameArena::reset() {
+    mPeak = std::max(mPeak, mUsed);
+
+    #ifdef GUI_DEBUG_MODE
+      // Make use-after-reset bugs obvious.
+      for (usize i = 0; i <= mCurrent && i < mBlocks.size(); ++i) {
+        std::memset(mBlocks[i].data, 0xCD, i == mCurrent ? mOffset : mBlocks[i].size);
+      }
+    #endif
+
+    // Merge the blocks into one big enough for the whole frame, so steady-state
+    // frames are served from a single block without touching the heap.
+    if (mBlocks.size() > 1) {
+      auto capacity = getCapacity();
+      for (auto& block : mBlocks) {
+        delete[] block.data;
+      }
+      mBlocks.clear();
+      mBlocks.push_back({new u8[capacity], capacity});
+    }
+
+    mCurrent = 0;
+    mOffset  = 0;
+    mUsed    = 0;
+  }
+
+  usize FrameArena::getCapacity() const {
+    usize capacity = 0;
+    for (auto& block : mBlocks) {
+      capacity += block.size;
+    }
+    return capacity;
+  }
+
+} // namespace Gui
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace Gui {
+
+  // Bump allocator for data that only lives for one frame. Memory is handed
+  // out linearly and released all at once by reset(), which the application
+  // calls at the start of every frame.
+  //
+  // Destructors are not run on reset, so only put trivially destructible data
+  // (or containers that are destroyed before the reset) in it.
+  class FrameArena {
+  public:
+    static constexpr const usize DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+  public:
+    // The arena of the calling thread.
+    static FrameArena& get();
+
+    FrameArena(usize blockSize = DEFAULT_BLOCK_SIZE);
+    DISALLOW_MOVE_AND_COPY(FrameArena);
+    ~FrameArena();
+
+    void* allocate(usize size, usize alignment = alignof(std::max_align_t));
+
+    template<typename T>
+    inline T* allocate(usize count = 1) {
+      return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    void reset();
+
+    inline usize getUsed() const { return mUsed; }
+    inline usize getPeak() const { return mPeak; }
+    usize getCapacity() const;
+
+  private:
+    struct Block {
+      u8* data;
+      usize size;
+    };
+
+    void* allocateFromNextBlock(usize size, usize alignment);
+
+  private:
+    usize mBlockSize;
+    std::vector<Block> mBlocks;
+    usize mCurrent = 0;
+    usize mOffset  = 0;
+    usize mUsed    = 0;
+    usize mPeak    = 0;
+  };
+
+  // STL allocator that allocates from a FrameArena, deallocation is a no-op.
+  template<typename T>
+  class FrameAllocator {
+  public:
+    using value_type = T;
+
+  public:
+    FrameAllocator()
+      : mArena{&FrameArena::get()}
+    {}
+
+    FrameAllocator(FrameArena& arena)
+      : mArena{&arena}
+    {}
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other)
+      : mArena{other.getArena()}
+    {}
+
+    inline T* allocate(usize count) { return mArena->allocate<T>(count); }
+    inline void deallocate(T*, usize) {}
+
+    inline FrameArena* getArena() const { return mArena; }
+
+    template<typename U>
+    inline bool operator==(const FrameAllocator<U>& other) const { return mArena == other.getArena(); }
+    template<typename U>
+    inline bool operator!=(const FrameAllocator<U>& other) const { return mArena != other.getArena(); }
+
+  private:
+    FrameArena* mArena;
+  };
+
+  template<typename T>
+  using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace Gui
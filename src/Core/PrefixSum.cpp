@@ -0,0 +1,61 @@
+#include "Core/PrefixSum.hpp"
+
+namespace Gui {
+
+  void PrefixSum::assign(usize count, f64 size) {
+    mSizes.assign(count, size);
+    mTree.assign(count + 1, 0.0);
+    for (usize i = 1; i <= count; ++i) {
+      mTree[i] += size;
+      const usize parent = i + (i & (~i + 1));
+      if (parent <= count) {
+        mTree[parent] += mTree[i];
+      }
+    }
+    mTotal = size * (f64)count;
+  }
+
+  void PrefixSum::set(usize index, f64 size) {
+    const f64 delta = size - mSizes[index];
+    if (delta == 0.0) {
+      return;
+    }
+
+    mSizes[index] = size;
+    mTotal += delta;
+    for (usize i = index + 1; i < mTree.size(); i += i & (~i + 1)) {
+      mTree[i] += delta;
+    }
+  }
+
+  f64 PrefixSum::offsetOf(usize index) const {
+    f64 result = 0.0;
+    for (usize i = index; i != 0; i -= i & (~i + 1)) {
+      result += mTree[i];
+    }
+    return result;
+  }
+
+  usize PrefixSum::indexAt(f64 offset) const {
+    const usize count = mSizes.size();
+    if (count == 0) {
+      return 0;
+    }
+
+    usize step = 1;
+    while (step * 2 <= count) {
+      step *= 2;
+    }
+
+    // The number of items that end at or before the offset.
+    usize position = 0;
+    for (; step != 0; step /= 2) {
+      if (position + step <= count && mTree[position + step] <= offset) {
+        position += step;
+        offset -= mTree[position];
+      }
+    }
+    return position < count ? position : count - 1;
+  }
+
+} // namespace Gui
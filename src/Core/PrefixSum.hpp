@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <vector>
+
+namespace Gui {
+
+  // Sizes of consecutive items, e.g. row heights, and the offsets they add up
+  // to. Changing a size, the offset of an item and the item at an offset are
+  // all O(log n), so a list of millions of rows can be measured as it scrolls.
+  class PrefixSum {
+  public:
+    PrefixSum() = default;
+
+    // O(n).
+    void assign(usize count, f64 size);
+
+    void set(usize index, f64 size);
+    inline f64 get(usize index) const { return mSizes[index]; }
+
+    // Sum of the sizes before `index`.
+    f64 offsetOf(usize index) const;
+
+    // Item covering `offset`, clamped to the items.
+    usize indexAt(f64 offset) const;
+
+    inline f64 getTotal() const { return mTotal; }
+    inline usize size() const { return mSizes.size(); }
+
+  private:
+    // Fenwick tree, one based.
+    std::vector<f64> mTree;
+    std::vector<f64> mSizes;
+    f64 mTotal = 0.0;
+  };
+
+} // namespace Gui
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "Core/Macro.hpp"
+#include "Core/Type.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#ifdef GUI_ATOMIC_REFCOUNT
+# include <atomic>
+#endif
+
+namespace Gui {
+
+  // Base of intrusively reference counted objects, held through Ref<T>.
+  //
+  // The count lives in the object, so a handle is a single pointer and there
+  // is no separate control block. Handles are only touched from the UI thread,
+  // so the count is a plain integer unless GUI_ATOMIC_REFCOUNT is defined.
+  class RefCounted {
+  public:
+    inline void incrementRefCount() const { mRefCount++; }
+
+    // Returns true when the last reference was dropped.
+    inline bool decrementRefCount() const {
+      GUI_DEBUG_ASSERT(mRefCount > 0);
+      return --mRefCount == 0;
+    }
+
+    inline u32 getRefCount() const { return mRefCount; }
+
+  protected:
+    RefCounted() = default;
+    ~RefCounted() = default;
+
+    // The count belongs to the object, not its contents.
+    RefCounted(const RefCounted&) {}
+    RefCounted& operator=(const RefCounted&) { return *this; }
+
+  private:
+#ifdef GUI_ATOMIC_REFCOUNT
+    mutable std::atomic<u32> mRefCount{0};
+#else
+    mutable u32 mRefCount = 0;
+#endif
+  };
+
+  template<typename T>
+  class Ref {
+    template<typename U>
+    friend class Ref;
+
+  public:
+    Ref() = default;
+    Ref(std::nullptr_t) {}
+
+    // Takes a reference to the object, which must have been created with new.
+    explicit Ref(T* pointer)
+      : mPointer{pointer}
+    {
+      retain();
+    }
+
+    Ref(const Ref& other)
+      : mPointer{other.mPointer}
+    {
+      retain();
+    }
+
+    Ref(Ref&& other) noexcept
+      : mPointer{other.mPointer}
+    {
+      other.mPointer = nullptr;
+    }
+
+    template<typename U>
+    Ref(const Ref<U>& other)
+      : mPointer{other.mPointer}
+    {
+      retain();
+    }
+
+    template<typename U>
+    Ref(Ref<U>&& other) noexcept
+      : mPointer{other.mPointer}
+    {
+      other.mPointer = nullptr;
+    }
+
+    ~Ref() { release(); }
+
+    Ref& operator=(const Ref& other) {
+      Ref(other).swap(*this);
+      return *this;
+    }
+
+    Ref& operator=(Ref&& other) noexcept {
+      Ref(std::move(other)).swap(*this);
+      return *this;
+    }
+
+    Ref& operator=(std::nullptr_t) {
+      reset();
+      return *this;
+    }
+
+    inline void reset() {
+      release();
+      mPointer = nullptr;
+    }
+
+    inline void swap(Ref& other) noexcept { std::swap(mPointer, other.mPointer); }
+
+    inline T* get() const { return mPointer; }
+    inline T* operator->() const { return mPointer; }
+    inline T& operator*() const { return *mPointer; }
+    inline explicit operator bool() const { return mPointer != nullptr; }
+
+    inline u32 getRefCount() const { return mPointer ? mPointer->getRefCount() : 0; }
+
+    template<typename U>
+    inline bool operator==(const Ref<U>& other) const { return mPointer == other.mPointer; }
+    template<typename U>
+    inline bool operator!=(const Ref<U>& other) const { return mPointer != other.mPointer; }
+    inline bool operator==(std::nullptr_t) const { return mPointer == nullptr; }
+    inline bool operator!=(std::nullptr_t) const { return mPointer != nullptr; }
+
+  private:
+    inline void retain() {
+      if (mPointer) {
+        mPointer->incrementRefCount();
+      }
+    }
+
+    inline void release() {
+      if (mPointer && mPointer->decrementRefCount()) {
+        delete mPointer;
+      }
+    }
+
+  private:
+    T* mPointer = nullptr;
+  };
+
+  template<typename T, typename ...Args>
+  inline Ref<T> makeRef(Args&&... args) {
+    return Ref<T>(new T(std::forward<Args>(args)...));
+  }
+
+} // namespace Gui
+
+namespace std {
+
+  template<typename T>
+  struct hash<Gui::Ref<T>> {
+    std::size_t operator()(const Gui::Ref<T>& ref) const noexcept {
+      return std::hash<T*>{}(ref.get());
+    }
+  };
+
+} // namespace std
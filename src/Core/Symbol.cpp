@@ -0,0 +1,70 @@
+#include "Core/Base.hpp"
+#include "Core/Symbol.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace Gui {
+
+  namespace {
+    struct SymbolTable {
+      std::mutex mutex;
+
+      // Deque, so the strings don't move when the table grows.
+      std::deque<String> strings{""};
+      std::unordered_map<StringView, u32> ids{{strings.front(), 0}};
+    };
+
+    SymbolTable& getSymbolTable() {
+      static SymbolTable table;
+      return table;
+    }
+  }
+
+  Symbol Symbol::intern(StringView string) {
+    if (string.empty()) {
+      return Symbol();
+    }
+
+    auto& table = getSymbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto it = table.ids.find(string);
+    if (it != table.ids.end()) {
+      return Symbol(it->second);
+    }
+
+    GUI_ASSERT_WITH_MESSAGE(table.strings.size() < UINT32_MAX, "too many interned symbols");
+    const auto id = (u32)table.strings.size();
+    table.strings.emplace_back(string);
+    table.ids.emplace(table.strings.back(), id);
+    return Symbol(id);
+  }
+
+  Option<Symbol> Symbol::find(StringView string) {
+    if (string.empty()) {
+      return Symbol();
+    }
+
+    auto& table = getSymbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto it = table.ids.find(string);
+    if (it == table.ids.end()) {
+      return None;
+    }
+    return Symbol(it->second);
+  }
+
+  StringView Symbol::toString() const {
+    if (mId == 0) {
+      return {};
+    }
+
+    auto& table = getSymbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.strings[mId];
+  }
+
+} // namespace Gui
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+namespace Gui {
+
+  // Interned string, stored as a 32-bit index into a global table.
+  // Comparing two symbols compares the indices.
+  class Symbol {
+  public:
+    // The empty string.
+    Symbol() = default;
+
+    static Symbol intern(StringView string);
+
+    // Does not intern the string, returns None if it never was.
+    static Option<Symbol> find(StringView string);
+
+    StringView toString() const;
+
+    inline u32 getId() const { return mId; }
+    inline bool isEmpty() const { return mId == 0; }
+
+    inline bool operator==(Symbol other) const { return mId == other.mId; }
+    inline bool operator!=(Symbol other) const { return mId != other.mId; }
+
+  private:
+    explicit Symbol(u32 id)
+      : mId{id}
+    {}
+
+  private:
+    u32 mId = 0;
+  };
+
+} // namespace Gui
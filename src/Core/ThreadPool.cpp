@@ -0,0 +1,63 @@
+#include "Core/Base.hpp"
+#include "Core/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace Gui {
+
+  ThreadPool& ThreadPool::get() {
+    #ifdef GUI_PLATFORM_WEB
+      static ThreadPool pool(0);
+    #else
+      static ThreadPool pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+    #endif
+    return pool;
+  }
+
+  ThreadPool::ThreadPool(u32 threadCount) {
+    for (u32 i = 0; i < threadCount; ++i) {
+      mThreads.emplace_back([this] { work(); });
+    }
+  }
+
+  ThreadPool::~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStopping = true;
+    }
+    mCondition.notify_all();
+    for (auto& thread : mThreads) {
+      thread.join();
+    }
+  }
+
+  void ThreadPool::submit(Job job) {
+    if (mThreads.empty()) {
+      job();
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mJobs.push_back(std::move(job));
+    }
+    mCondition.notify_one();
+  }
+
+  void ThreadPool::work() {
+    while (true) {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this] { return mStopping || !mJobs.empty(); });
+        if (mJobs.empty()) {
+          return;
+        }
+        job = std::move(mJobs.front());
+        mJobs.pop_front();
+      }
+      job();
+    }
+  }
+
+} // namespace Gui
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Gui {
+
+  // Fixed set of worker threads running jobs in submission order.
+  //
+  // On the web there are no threads, jobs run inline in submit().
+  class ThreadPool {
+  public:
+    using Job = std::function<void()>;
+
+  public:
+    // Shared pool, created on first use with one worker per core but one.
+    static ThreadPool& get();
+
+    ThreadPool(u32 threadCount);
+    DISALLOW_MOVE_AND_COPY(ThreadPool);
+
+    // Waits for the queued jobs to finish.
+    ~ThreadPool();
+
+    void submit(Job job);
+
+    inline u32 getThreadCount() const { return (u32)mThreads.size(); }
+
+  private:
+    void work();
+
+  private:
+    std::vector<std::thread> mThreads;
+    std::deque<Job> mJobs;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStopping = false;
+  };
+
+} // namespace Gui
@@ -0,0 +1,277 @@
+#include "Events/EventRecorder.hpp"
+#include "Events/WindowEvent.hpp"
+#include "Events/FileDropEvent.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Gui {
+
+  EventRecorder::Handle EventRecorder::create(const String& path, u32 width, u32 height) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+      Logger::error("Could not open event recording file: %s", path.c_str());
+      return nullptr;
+    }
+
+    auto result = std::make_shared<EventRecorder>(file);
+    result->write(MAGIC, sizeof(MAGIC));
+    result->write<u16>(VERSION);
+    result->write<u16>(0);
+    result->write<u32>(width);
+    result->write<u32>(height);
+    Logger::trace("Recording events to %s", path.c_str());
+    return result;
+  }
+
+  EventRecorder::~EventRecorder() {
+    std::fclose(mFile);
+    Logger::trace("Recorded %llu events", (unsigned long long)mRecordCount);
+  }
+
+  void EventRecorder::write(const void* data, usize size) {
+    std::fwrite(data, 1, size, mFile);
+  }
+
+  void EventRecorder::flush() {
+    std::fflush(mFile);
+  }
+
+  void EventRecorder::record(const Event& event) {
+    auto now = std::chrono::steady_clock::now();
+    auto delta = std::chrono::duration_cast<std::chrono::microseconds>(now - mLastTime).count();
+    mLastTime = now;
+
+    write<u8>((u8)event.getType());
+    write<u32>((u32)delta);
+
+    switch (event.getType()) {
+      case Event::Type::KeyPressed: {
+        auto& e = (const KeyPressedEvent&)event;
+        write<i16>((i16)e.getKey());
+        write<u8>((u8)e.getModifier());
+        write<u8>(e.isRepeat() ? 1 : 0);
+      } break;
+      case Event::Type::KeyReleased: {
+        auto& e = (const KeyReleasedEvent&)event;
+        write<i16>((i16)e.getKey());
+      } break;
+      case Event::Type::MouseMove: {
+        auto& e = (const MouseMoveEvent&)event;
+        write<f32>(e.getX());
+        write<f32>(e.getY());
+      } break;
+      case Event::Type::MouseScroll: {
+        auto& e = (const MouseScrollEvent&)event;
+        write<f32>(e.getXOffset());
+        write<f32>(e.getYOffset());
+      } break;
+      case Event::Type::MouseButtonPressed:
+      case Event::Type::MouseButtonReleased: {
+        auto& e = (const MouseButtonEvent&)event;
+        write<u8>((u8)e.getButton());
+      } break;
+      case Event::Type::WindowResize: {
+        auto& e = (const WindowResizeEvent&)event;
+        write<u32>(e.getWidth());
+        write<u32>(e.getHeight());
+      } break;
+      case Event::Type::FileDropEvent: {
+        auto& e = (const FileDropEvent&)event;
+        auto& paths = e.getPaths();
+        write<u16>((u16)paths.size());
+        for (usize i = 0; i < (u16)paths.size(); ++i) {
+          u16 length = (u16)std::min<usize>(paths[i].size(), UINT16_MAX);
+          write<u16>(length);
+          write(paths[i].data(), length);
+        }
+      } break;
+      case Event::Type::WindowClose:
+      case Event::Type::WindowMinimized:
+        break;
+    }
+
+    mRecordCount++;
+  }
+
+  namespace {
+    class Reader {
+    public:
+      Reader(const std::vector<u8>& data)
+        : mData{data}
+      {}
+
+      bool read(void* data, usize size) {
+        if (mOffset + size > mData.size()) {
+          return false;
+        }
+        std::memcpy(data, mData.data() + mOffset, size);
+        mOffset += size;
+        return true;
+      }
+
+      template<typename T>
+      bool read(T& value) {
+        return read(&value, sizeof(T));
+      }
+
+      bool isAtEnd() const { return mOffset == mData.size(); }
+
+    private:
+      const std::vector<u8>& mData;
+      usize mOffset = 0;
+    };
+  }
+
+  Option<EventRecording> EventRecording::load(const String& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+      Logger::error("Could not open event recording file: %s", path.c_str());
+      return None;
+    }
+
+    std::vector<u8> data;
+    u8 chunk[4096];
+    usize count;
+    while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+      data.insert(data.end(), chunk, chunk + count);
+    }
+    std::fclose(file);
+
+    Reader reader(data);
+
+    char magic[4];
+    u16 version;
+    u16 reserved;
+    EventRecording result;
+    if (
+      !reader.read(magic, sizeof(magic))
+      || std::memcmp(magic, EventRecorder::MAGIC, sizeof(magic)) != 0
+      || !reader.read(version)
+      || !reader.read(reserved)
+      || !reader.read(result.mWidth)
+      || !reader.read(result.mHeight)
+    ) {
+      Logger::error("Invalid event recording file: %s", path.c_str());
+      return None;
+    }
+
+    if (version != EventRecorder::VERSION) {
+      Logger::error("Unsupported event recording version %d: %s", version, path.c_str());
+      return None;
+    }
+
+    f64 time = 0.0;
+    while (!reader.isAtEnd()) {
+      u8 type;
+      u32 delta;
+      if (!reader.read(type) || !reader.read(delta) || type > (u8)Event::Type::FileDropEvent) {
+        Logger::error("Truncated event recording file: %s", path.c_str());
+        return None;
+      }
+      time += (f64)delta / 1'000'000.0;
+
+      Record record;
+      record.type = (Event::Type)type;
+      record.time = time;
+
+      bool ok = true;
+      switch (record.type) {
+        case Event::Type::KeyPressed: {
+          i16 key;
+          u8 modifier, repeat;
+          ok = reader.read(key) && reader.read(modifier) && reader.read(repeat);
+          record.key      = (Key)key;
+          record.modifier = (KeyModifier)modifier;
+          record.repeat   = repeat != 0;
+        } break;
+        case Event::Type::KeyReleased: {
+          i16 key;
+          ok = reader.read(key);
+          record.key = (Key)key;
+        } break;
+        case Event::Type::MouseMove:
+        case Event::Type::MouseScroll:
+          ok = reader.read(record.position.x) && reader.read(record.position.y);
+          break;
+        case Event::Type::MouseButtonPressed:
+        case Event::Type::MouseButtonReleased: {
+          u8 button;
+          ok = reader.read(button);
+          record.button = (MouseButton)button;
+        } break;
+        case Event::Type::WindowResize:
+          ok = reader.read(record.width) && reader.read(record.height);
+          break;
+        case Event::Type::FileDropEvent: {
+          u16 pathCount;
+          ok = reader.read(pathCount);
+          for (u16 i = 0; ok && i < pathCount; ++i) {
+            u16 length;
+            String dropped;
+            ok = reader.read(length);
+            if (ok) {
+              dropped.resize(length);
+              ok = reader.read(dropped.data(), length);
+            }
+            record.paths.push_back(std::move(dropped));
+          }
+        } break;
+        case Event::Type::WindowClose:
+        case Event::Type::WindowMinimized:
+          break;
+      }
+
+      if (!ok) {
+        Logger::error("Truncated event recording file: %s", path.c_str());
+        return None;
+      }
+
+      result.mRecords.push_back(std::move(record));
+    }
+
+    Logger::trace("Loaded %zu events (%.2fs) from %s", result.mRecords.size(), result.getDuration(), path.c_str());
+    return result;
+  }
+
+  void EventRecording::dispatch(const Record& record, const std::function<void(const Event&)>& callback) {
+    switch (record.type) {
+      case Event::Type::KeyPressed:
+        callback(KeyPressedEvent(record.key, record.modifier, record.repeat));
+        break;
+      case Event::Type::KeyReleased:
+        callback(KeyReleasedEvent(record.key));
+        break;
+      case Event::Type::MouseMove:
+        callback(MouseMoveEvent(record.position.x, record.position.y));
+        break;
+      case Event::Type::MouseScroll:
+        callback(MouseScrollEvent(record.position.x, record.position.y));
+        break;
+      case Event::Type::MouseButtonPressed:
+        callback(MouseButtonPressedEvent(record.button));
+        break;
+      case Event::Type::MouseButtonReleased:
+        callback(MouseButtonReleasedEvent(record.button));
+        break;
+      case Event::Type::WindowResize:
+        callback(WindowResizeEvent(record.width, record.height));
+        break;
+      case Event::Type::WindowClose:
+        callback(WindowCloseEvent());
+        break;
+      case Event::Type::WindowMinimized:
+        callback(WindowMinimizedEvent());
+        break;
+      case Event::Type::FileDropEvent: {
+        FileDropEvent::Paths paths;
+        paths.reserve(record.paths.size());
+        for (auto& path : record.paths) {
+          paths.emplace_back(path);
+        }
+        callback(FileDropEvent(std::move(paths)));
+      } break;
+    }
+  }
+
+} // namespace Gui
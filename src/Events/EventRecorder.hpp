@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Core/Base.hpp"
+#include "Events/Event.hpp"
+#include "Events/KeyEvent.hpp"
+#include "Events/MouseEvent.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace Gui {
+
+  // Binary event log format, native byte order (little endian on every platform we target):
+  //
+  //   header: "GUIE" | u16 version | u16 reserved | u32 width | u32 height
+  //   record: u8 type | u32 microseconds since the previous record | payload
+  //
+  // Payloads:
+  //   KeyPressed:              i16 key | u8 modifier | u8 repeat
+  //   KeyReleased:             i16 key
+  //   MouseMove, MouseScroll:  f32 x | f32 y
+  //   MouseButton*:            u8 button
+  //   WindowResize:            u32 width | u32 height
+  //   FileDropEvent:           u16 count | count * (u16 length | bytes)
+  //   WindowClose, WindowMinimized: nothing
+  class EventRecorder {
+  public:
+    using Handle = std::shared_ptr<EventRecorder>;
+
+    static constexpr const char MAGIC[4] = {'G', 'U', 'I', 'E'};
+    static constexpr const u16 VERSION   = 1;
+
+  public:
+    static EventRecorder::Handle create(const String& path, u32 width, u32 height);
+    DISALLOW_MOVE_AND_COPY(EventRecorder);
+    ~EventRecorder();
+
+    void record(const Event& event);
+    void flush();
+
+    inline u64 getRecordCount() const { return mRecordCount; }
+
+  public:
+    // DO NOT USE! Use EventRecorder::create()
+    EventRecorder(std::FILE* file)
+      : mFile{file}, mLastTime{std::chrono::steady_clock::now()}
+    {}
+
+  private:
+    void write(const void* data, usize size);
+
+    template<typename T>
+    void write(T value) {
+      write(&value, sizeof(T));
+    }
+
+  private:
+    std::FILE* mFile;
+    std::chrono::steady_clock::time_point mLastTime;
+    u64 mRecordCount = 0;
+  };
+
+  class EventRecording {
+  public:
+    struct Record {
+      Event::Type type;
+
+      // Seconds since the start of the recording.
+      f64 time;
+
+      Key key                 = Key::Unknown;
+      KeyModifier modifier    = KeyModifier::None;
+      bool repeat             = false;
+      MouseButton button      = MouseButton::Left;
+      Vec2 position           = {0.0f, 0.0f};
+      u32 width               = 0;
+      u32 height              = 0;
+      std::vector<String> paths;
+    };
+
+  public:
+    static Option<EventRecording> load(const String& path);
+
+    // Reconstructs the recorded event and passes it to the callback.
+    static void dispatch(const Record& record, const std::function<void(const Event&)>& callback);
+
+    inline u32 getWidth() const { return mWidth; }
+    inline u32 getHeight() const { return mHeight; }
+    inline f64 getDuration() const { return mRecords.empty() ? 0.0 : mRecords.back().time; }
+    inline const std::vector<Record>& getRecords() const { return mRecords; }
+
+  private:
+    EventRecording() = default;
+
+  private:
+    u32 mWidth  = 0;
+    u32 mHeight = 0;
+    std::vector<Record> mRecords;
+  };
+
+} // namespace Gui
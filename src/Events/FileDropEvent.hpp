@@ -1,25 +1,27 @@
 #pragma once
 
 #include "Core/Base.hpp"
+#include "Core/FrameArena.hpp"
 #include "Events/Event.hpp"
 
-#include <vector>
-
 namespace Gui {
 
   class FileDropEvent : public Event {
   public:
     inline static constexpr const auto TYPE = Event::Type::FileDropEvent;
 
+    // The paths live in the frame arena, copy them to keep them past the next frame.
+    using Paths = FrameVector<StringView>;
+
   public:
-    FileDropEvent(std::vector<String> paths)
-      : Event(TYPE), mPaths{ paths }
+    FileDropEvent(Paths paths)
+      : Event(TYPE), mPaths{std::move(paths)}
     {}
 
-    inline const std::vector<String>& getPaths() const { return mPaths; }
+    inline const Paths& getPaths() const { return mPaths; }
 
   private:
-    std::vector<String> mPaths;
+    Paths mPaths;
   };
 
-} // namespace Gui
\ No newline at end of file
+} // namespace Gui
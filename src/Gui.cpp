@@ -7,6 +7,15 @@
 #include "Events/WindowEvent.hpp"
 #include "Events/FileDropEvent.hpp"
 #include "Gui.hpp"
+#include "Renderer/GLState.hpp"
+#include "Renderer/RenderCache.hpp"
+#include "Renderer/TextureCache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 #ifdef GUI_PLATFORM_WEB
 #  include <emscripten/emscripten.h>
@@ -36,15 +45,17 @@ namespace Gui {
     Logger::error("GLFW Error (%d): %s", error, description);
   }
 
-  void Window::initializeWindowSystem() {
+  bool Window::initializeWindowSystem() {
     glfwSetErrorCallback(GLFWErrorCallback);
 
     Logger::info("GLFW Version: %s", glfwGetVersionString());
     if (!glfwInit()) {
-      std::exit(EXIT_FAILURE);
-    } else {
-      Logger::trace("GLFW initialized!");
+      Logger::error("GLFW: Failed to initialize");
+      return false;
     }
+
+    Logger::trace("GLFW initialized!");
+    return true;
   }
 
   void Window::deinitializeWindowSystem() {
@@ -112,15 +123,18 @@ namespace Gui {
   }
 #endif
 
-  Window::Handle Window::create(const char* title, u32 width, u32 height) {
-    initializeWindowSystem();
+  Window::Handle Window::create(const char* title, u32 width, u32 height, bool visible, AntiAliasing antiAliasing) {
+    if (!initializeWindowSystem()) {
+      return nullptr;
+    }
 
     Logger::trace("Creating window...");
 
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_SAMPLES, 4);
+    glfwWindowHint(GLFW_SAMPLES, (int)antiAliasing);
+    glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
 
     #ifdef __APPLE__
       glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
@@ -134,6 +148,7 @@ namespace Gui {
     data.window = nullptr;
     data.width = width;
     data.height = height;
+    data.antiAliasing = antiAliasing;
     data.eventCallback = [](auto&) {};
 
     data.window = glfwCreateWindow(width, height, title, nullptr, nullptr);
@@ -144,6 +159,9 @@ namespace Gui {
 
     glfwMakeContextCurrent(result->data.window);
 
+    // Nothing of a previous context is bound in the new one.
+    GLState::get().invalidate();
+
     // We dont need to do this, for web since emscripten does this.
     #ifndef GUI_PLATFORM_WEB
       if (!gladLoadGLLoader(GLADloadproc(glfwGetProcAddress)))
@@ -176,20 +194,20 @@ namespace Gui {
       auto& data = *(Data*)glfwGetWindowUserPointer(window);
       if (width == 0 && height == 0) { // window minimized
         WindowMinimizedEvent event;
-        data.eventCallback(event);
+        emit(data, event);
         return;
       }
 
       data.width  = width;
       data.height = height;
       WindowResizeEvent event(width, height);
-      data.eventCallback(event);
+      emit(data, event);
     });
 
     glfwSetWindowCloseCallback(result->data.window, [](GLFWwindow* window) {
       auto& data = *(Data*)glfwGetWindowUserPointer(window);
       WindowCloseEvent event;
-      data.eventCallback(event);
+      emit(data, event);
     });
 
     glfwSetKeyCallback(result->data.window, [](GLFWwindow* window, int keyCode, int scancode, int action, int mods) {
@@ -202,17 +220,17 @@ namespace Gui {
       switch (action) {
 				case GLFW_PRESS: {
 					KeyPressedEvent event(key, modifier, false);
-					data.eventCallback(event);
+					emit(data, event);
 					break;
 				}
 				case GLFW_RELEASE: {
 					KeyReleasedEvent event(key);
-					data.eventCallback(event);
+					emit(data, event);
 					break;
 				}
 				case GLFW_REPEAT: {
 					KeyPressedEvent event(key, modifier, true);
-					data.eventCallback(event);
+					emit(data, event);
 					break;
 				}
 			}
@@ -226,12 +244,12 @@ namespace Gui {
 			switch (action) {
 				case GLFW_PRESS: {
 					MouseButtonPressedEvent event((MouseButton)button);
-					data.eventCallback(event);
+					emit(data, event);
 					break;
 				}
 				case GLFW_RELEASE: {
 					MouseButtonReleasedEvent event((MouseButton)button);
-					data.eventCallback(event);
+					emit(data, event);
 					break;
 				}
 			}
@@ -241,13 +259,13 @@ namespace Gui {
 			auto& data = *(Data*)glfwGetWindowUserPointer(window);
 
 			MouseScrollEvent event(static_cast<f32>(xOffset), static_cast<f32>(yOffset));
-			data.eventCallback(event);
+			emit(data, event);
 		});
 
     glfwSetCursorPosCallback(result->data.window, [](GLFWwindow* window, double x, double y) {
       auto& data = *(Data*)glfwGetWindowUserPointer(window);
       MouseMoveEvent event(static_cast<f32>(x), static_cast<f32>(y));
-      data.eventCallback(event);
+      emit(data, event);
     });
 
     glfwSetDropCallback(result->data.window, [](GLFWwindow* window, int count, const char** paths) {
@@ -255,13 +273,18 @@ namespace Gui {
       if (count <= 0) {
         return;
       }
-      std::vector<String> result;
+      auto& arena = FrameArena::get();
+      FileDropEvent::Paths result(arena);
+      result.reserve(count);
       for (int i = 0; i < count; ++i) {
-        result.emplace_back(paths[i]);
+        const usize length = std::strlen(paths[i]);
+        char* path = arena.allocate<char>(length);
+        std::memcpy(path, paths[i], length);
+        result.emplace_back(path, length);
       }
       auto& data = *(Data*)glfwGetWindowUserPointer(window);
-      FileDropEvent event(result);
-      data.eventCallback(event);
+      FileDropEvent event(std::move(result));
+      emit(data, event);
     });
 
     // Center window, if possible.
@@ -282,6 +305,13 @@ namespace Gui {
     return result;
   }
 
+  void Window::emit(Data& data, const Event& event) {
+    if (data.recorder) {
+      data.recorder->record(event);
+    }
+    data.eventCallback(event);
+  }
+
   void Window::setSize(u32 width, u32 height) {
     glfwSetWindowSize(this->data.window, width, height);
   }
@@ -291,7 +321,15 @@ namespace Gui {
   }
 
   void Window::update() {
+    pollEvents();
+    swapBuffers();
+  }
+
+  void Window::pollEvents() {
     glfwPollEvents();
+  }
+
+  void Window::swapBuffers() {
     glfwSwapBuffers(this->data.window);
   }
 
@@ -316,6 +354,23 @@ namespace Gui {
     glfwSetWindowTitle(data.window, title.c_str());
   }
 
+  void Window::setVisible(bool visible) {
+    if (visible) {
+      glfwShowWindow(this->data.window);
+    } else {
+      glfwHideWindow(this->data.window);
+    }
+  }
+
+  bool Window::startRecording(const String& path) {
+    this->data.recorder = EventRecorder::create(path, this->data.width, this->data.height);
+    return this->data.recorder != nullptr;
+  }
+
+  void Window::stopRecording() {
+    this->data.recorder = nullptr;
+  }
+
   void Window::setEventCallback(EventCallback callback) {
     this->data.eventCallback = callback;
   }
@@ -333,134 +388,85 @@ namespace Gui {
     }
   }
 
-  Application::Application(std::string title, u32 widget, u32 height)
+  static Window::Handle createApplicationWindow(const std::string& title, u32 width, u32 height, AntiAliasing antiAliasing) {
+    auto window = Window::create(title.c_str(), width, height, true, antiAliasing);
+    if (!window) {
+      Logger::error("Failed to create application window");
+      std::exit(EXIT_FAILURE);
+    }
+    return window;
+  }
+
+  Application::Application(std::string title, u32 widget, u32 height, AntiAliasing antiAliasing)
     : mWidth{widget},
       mHeight{height},
-      mWindow(Window::create(title.c_str(), widget, height)),
+      mWindow(createApplicationWindow(title, widget, height, antiAliasing)),
       mCamera(mWidth, mHeight, mWindow->getAspectRatio()),
       renderer(mWidth, mHeight)
   {
     mWindow->setVSync(true);
     mCamera.resize(mWidth, mHeight);
+    renderer.setAntiAliasing(antiAliasing);
     root = Container::create();
+
+    mUnfocusVisitor = [](const Widget::Handle& current) {
+      if (current->mFocused) {
+        current->mFocused = false;
+        current->markDirty();
+      }
+      return true;
+    };
+
+    mFindFocusedVisitor = [this](const Widget::Handle& current) {
+      if (current->mFocused) {
+        mDispatch.focused = current;
+        return false;
+      }
+      return true;
+    };
+
+    mKeyVisitor = [this](const Widget::Handle& current) {
+      if (current->hasKeyEventHandler()) {
+        Logger::trace("Key Event (%d) --> %p", mDispatch.keyEvent.key, (void*)current.get());
+
+        mDispatch.keyEvent.target = current;
+        const bool propagate = current->triggerKeyEvent(mDispatch.keyEvent);
+        current->markDirty();
+        return propagate;
+      }
+
+      return true;
+    };
   }
 
   void Application::resize(u32 width, u32 height) {
     mWidth = width;
     mHeight = height;
-    glViewport(0, 0, mWidth, mHeight);
+    GLState::get().viewport(0, 0, (i32)mWidth, (i32)mHeight);
     printf("width = %d, height = %d\n", mWidth, mHeight);
     mCamera.resize(mWidth, mHeight);
     renderer.invalidate(mWidth, mHeight);
   }
 
   void Application::run() {
-    mWindow->setEventCallback([&](const Gui::Event& event) {
-      if (event.getType() == Gui::Event::Type::WindowResize) {
-        auto[width, height] = ((Gui::WindowResizeEvent&)event).getSize();
-        resize(width, height);
-      } else if (event.getType() == Gui::Event::Type::MouseMove) {
-        auto[x, y] = ((MouseMoveEvent&)event).getPosition();
-        mMousePosition = {(float)x, (float)y};
-      } else if (event.getType() == Gui::Event::Type::MouseButtonPressed) {
-        auto button = ((MouseButtonEvent&)event).getButton();
-        auto x = mMousePosition.x;
-        auto y = mMousePosition.y;
-
-        Widget::Handle focused = nullptr;
-        Widget::Visitor focusVisitor = [&](Widget::Handle current) {
-          if (
-            !focused
-            && current->isFocusable()
-            && current->mPosition.x <= x
-            && current->mPosition.y <= y
-            && current->mPosition.x + current->mSize.x > x
-            && current->mPosition.y + current->mSize.y > y
-          ) {
-            Widget::Visitor innerVisitor = [&](Widget::Handle other) {
-              other->mFocused = false;
-              return true;
-            };
-            root->visit(root, innerVisitor);
-
-            current->mFocused = true;
-            focused = current;
-            return false;
-          }
-          return true;
-        };
-        root->visit(root, focusVisitor);
-
-        Widget::Visitor visitor = [&](Widget::Handle current) {
-          if (
-            current->mPosition.x <= x
-            && current->mPosition.y <= y
-            && current->mPosition.x + current->mSize.x > x
-            && current->mPosition.y + current->mSize.y > y
-          ) {
-            if (current->hasClickEventHandler()) {
-              Logger::trace("Click Event --> %p", (void*)current.get());
-
-              Widget::ClickEvent event = {
-                current,
-                mMousePosition,
-                button,
-              };
-              return current->click(event);
-            }
-          }
-
-          return true;
-        };
-
-        root->visit(root, visitor);
-      } else if (
-        event.getType() == Gui::Event::Type::KeyPressed
-        || event.getType() == Gui::Event::Type::KeyReleased
-      ) {
-        auto key = ((KeyEvent&)event).getKey();
-        auto is_pressed = event.getType() == Gui::Event::Type::KeyPressed;
-        auto modifier = KeyModifier::None;
-        if (is_pressed) {
-          modifier = ((KeyPressedEvent&)event).getModifier();
-        }
-
-        Widget::Handle focusedWidget = nullptr;
-        Widget::Visitor focusVisitor = [&](Widget::Handle current) {
-          if (current->mFocused) {
-            focusedWidget = current;
-            return false;
-          }
-          return true;
-        };
-        root->visit(root, focusVisitor);
-
-        Widget::KeyEvent keyEvent = {
-          focusedWidget,
-          key,
-          is_pressed ? Widget::KeyEventType::Pressed : Widget::KeyEventType::Released,
-          modifier,
-        };
-
-        if (focusedWidget) {
-          focusedWidget->triggerKeyEvent(keyEvent);
-          return;
+    #ifndef GUI_PLATFORM_WEB
+      // Set GUI_REPLAY_EVENTS to replay a recorded session instead of running
+      // interactively, or GUI_RECORD_EVENTS to record one.
+      if (const char* path = std::getenv("GUI_REPLAY_EVENTS")) {
+        ReplayOptions options;
+        options.headless = std::getenv("GUI_REPLAY_HEADLESS") != nullptr;
+        if (auto report = replay(path, options)) {
+          report->print();
         }
-
-        // TODO: Don't go depth first.
-        Widget::Visitor visitor = [&](Widget::Handle current) {
-          if (current->hasKeyEventHandler()) {
-            Logger::trace("Key Event (%d) --> %p", key, (void*)current.get());
-
-            keyEvent.target = current;
-            return current->triggerKeyEvent(keyEvent);
-          }
-
-          return true;
-        };
-
-        root->visit(root, visitor);
+        return;
+      }
+      if (const char* path = std::getenv("GUI_RECORD_EVENTS")) {
+        mWindow->startRecording(path);
       }
+    #endif
+
+    mWindow->setEventCallback([this](const Event& event) {
+      onEvent(event);
     });
 
     renderer.blending(true);
@@ -476,27 +482,316 @@ namespace Gui {
   }
 
   void Application::logicLoop() {
+    FrameArena::get().reset();
+
     mTime = (float)glfwGetTime();
     dt = mTime - mLastFrameTime;
     mLastFrameTime = mTime;
 
+    render();
+    mWindow->update();
+  }
+
+  void Application::render() {
+    GLState::get().beginFrame();
+    Texture::uploadPending();
+    TextureCache::get().trim();
+    RenderCache::get().beginFrame();
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     renderer.begin(mCamera.getCamera());
     renderer.clearScreen();
 
+    // From the previous frame's snapshot, so only the animating widgets are touched.
+    if (mWidgetTree.isStale(root)) {
+      mWidgetTree.rebuild(root);
+    }
+    for (WidgetTree::Id id = 0; id < mWidgetTree.size(); ++id) {
+      if (mWidgetTree.hasFlags(id, WidgetTree::Animated)) {
+        mWidgetTree.getWidget(id)->animate(dt);
+      }
+    }
+
     root->layout({0, 0, (float)mWidth, (float)mHeight});
-    root->draw(renderer);
+    mWidgetTree.rebuild(root);
+    cacheStableSubtrees();
+    root->render(renderer);
 
     onUpdate();
 
     renderer.end();
-    mWindow->update();
+
+    if (mCapture) {
+      mCapture->capture(0, mWidth, mHeight);
+    }
+  }
+
+  void Application::cacheStableSubtrees() {
+    const u32 frame = RenderCache::get().getFrame();
+
+    // Top down, so a subtree is cached rather than the subtrees in it. Only
+    // widgets that opted in with CacheMode::Auto are.
+    mCacheStack.clear();
+    if (!mWidgetTree.isEmpty()) {
+      mCacheStack.push_back(mWidgetTree.getRoot());
+    }
+    while (!mCacheStack.empty()) {
+      const auto id = mCacheStack.back();
+      mCacheStack.pop_back();
+
+      if (!mWidgetTree.hasFlags(id, WidgetTree::Visible) || mWidgetTree.getSubtreeSize(id) < RenderCache::AUTO_CACHE_MIN_WIDGETS) {
+        continue;
+      }
+
+      auto* widget = mWidgetTree.getWidget(id);
+      if (widget->isCached()) {
+        continue;
+      }
+
+      const bool fits = widget->mSize.x <= RenderCache::MAX_TARGET_SIZE && widget->mSize.y <= RenderCache::MAX_TARGET_SIZE;
+      if (fits && widget->getCacheMode() == Widget::CacheMode::Auto && frame - widget->getChangeFrame() >= RenderCache::AUTO_CACHE_STABLE_FRAMES) {
+        widget->cacheAutomatically();
+        continue;
+      }
+
+      for (auto child = mWidgetTree.getFirstChild(id); child != WidgetTree::NONE; child = mWidgetTree.getNextSibling(child)) {
+        mCacheStack.push_back(child);
+      }
+    }
+  }
+
+  void Application::startCapture(FrameCapture::Handle capture) {
+    stopCapture();
+    mCapture = std::move(capture);
+  }
+
+  void Application::stopCapture() {
+    if (mCapture) {
+      mCapture->flush();
+      mCapture = nullptr;
+    }
+  }
+
+  void Application::onEvent(const Event& event) {
+    if (event.getType() == Gui::Event::Type::WindowResize) {
+      auto[width, height] = ((Gui::WindowResizeEvent&)event).getSize();
+      resize(width, height);
+    } else if (event.getType() == Gui::Event::Type::MouseMove) {
+      auto[x, y] = ((MouseMoveEvent&)event).getPosition();
+      mMousePosition = {(float)x, (float)y};
+    } else if (event.getType() == Gui::Event::Type::MouseButtonPressed) {
+      auto button = ((MouseButtonEvent&)event).getButton();
+      auto position = mMousePosition;
+
+      // A handler of an earlier event may have removed widgets.
+      if (mWidgetTree.isStale(root)) {
+        mWidgetTree.rebuild(root);
+      }
+
+      auto focused = mWidgetTree.findAt(position, WidgetTree::Visible | WidgetTree::Focusable);
+      if (focused != WidgetTree::NONE) {
+        root->visit(root, mUnfocusVisitor);
+        mWidgetTree.getWidget(focused)->mFocused = true;
+        mWidgetTree.getWidget(focused)->markDirty();
+      }
+
+      // Hold references before any handler runs, a handler may remove widgets from the tree.
+      const u8 clickable = WidgetTree::Visible | WidgetTree::Clickable;
+      mDispatch.targets.clear();
+      for (auto id = mWidgetTree.findAt(position, clickable); id != WidgetTree::NONE; id = mWidgetTree.findAt(position, clickable, id + 1)) {
+        mDispatch.targets.push_back(mWidgetTree.getHandle(id));
+      }
+      for (const auto& current : mDispatch.targets) {
+        Logger::trace("Click Event --> %p", (void*)current.get());
+
+        Widget::ClickEvent clickEvent = {
+          current,
+          position,
+          button,
+        };
+        const bool propagate = current->click(clickEvent);
+        current->markDirty();
+        if (!propagate) {
+          break;
+        }
+      }
+      mDispatch.targets.clear();
+    } else if (event.getType() == Gui::Event::Type::MouseScroll) {
+      auto offset = ((MouseScrollEvent&)event).getOffset();
+      auto position = mMousePosition;
+
+      if (mWidgetTree.isStale(root)) {
+        mWidgetTree.rebuild(root);
+      }
+
+      const u8 scrollable = WidgetTree::Visible | WidgetTree::Scrollable;
+      mDispatch.targets.clear();
+      for (auto id = mWidgetTree.findAt(position, scrollable); id != WidgetTree::NONE; id = mWidgetTree.findAt(position, scrollable, id + 1)) {
+        mDispatch.targets.push_back(mWidgetTree.getHandle(id));
+      }
+      for (const auto& current : mDispatch.targets) {
+        Logger::trace("Scroll Event --> %p", (void*)current.get());
+
+        Widget::ScrollEvent scrollEvent = {
+          current,
+          position,
+          Vec2{offset.x, offset.y},
+        };
+        if (!current->scroll(scrollEvent)) {
+          break;
+        }
+      }
+      mDispatch.targets.clear();
+    } else if (
+      event.getType() == Gui::Event::Type::KeyPressed
+      || event.getType() == Gui::Event::Type::KeyReleased
+    ) {
+      auto key = ((KeyEvent&)event).getKey();
+      auto is_pressed = event.getType() == Gui::Event::Type::KeyPressed;
+      auto modifier = KeyModifier::None;
+      if (is_pressed) {
+        modifier = ((KeyPressedEvent&)event).getModifier();
+      }
+
+      mDispatch.focused = nullptr;
+      root->visit(root, mFindFocusedVisitor);
+
+      mDispatch.keyEvent = {
+        mDispatch.focused,
+        key,
+        is_pressed ? Widget::KeyEventType::Pressed : Widget::KeyEventType::Released,
+        modifier,
+      };
+
+      if (mDispatch.focused) {
+        mDispatch.focused->triggerKeyEvent(mDispatch.keyEvent);
+        mDispatch.focused->markDirty();
+      } else {
+        // TODO: Don't go depth first.
+        root->visit(root, mKeyVisitor);
+      }
+
+      // Don't keep the widgets alive past the event.
+      mDispatch.focused = nullptr;
+      mDispatch.keyEvent.target = nullptr;
+    }
+  }
+
+  Option<ReplayReport> Application::replay(const String& path, ReplayOptions options) {
+    GUI_ASSERT_WITH_MESSAGE(options.timestep > 0.0f, "replay timestep must be positive");
+
+    #ifdef GUI_PLATFORM_WEB
+      (void)path;
+      Logger::error("Event replay is not supported on the web");
+      return None;
+    #else
+      auto recording = EventRecording::load(path);
+      if (!recording) {
+        return None;
+      }
+
+      if (options.headless) {
+        mWindow->setVisible(false);
+      }
+
+      // Live input must not interfere with the recorded one.
+      mWindow->setEventCallback([](const Event&) {});
+      mWindow->setVSync(false);
+      renderer.blending(true);
+
+      if (recording->getWidth() != 0 && recording->getHeight() != 0) {
+        mWindow->setSize(recording->getWidth(), recording->getHeight());
+        resize(recording->getWidth(), recording->getHeight());
+      }
+
+      const auto& records = recording->getRecords();
+      const u32 frameCount = (u32)std::ceil(recording->getDuration() / options.timestep) + 1;
+
+      ReplayReport report;
+      report.frameTimes.reserve(frameCount);
+
+      auto dispatch = [this](const Event& event) { onEvent(event); };
+
+      usize next = 0;
+      mLastFrameTime = 0.0f;
+      for (u32 frame = 0; frame < frameCount && !mWindow->shouldClose(); ++frame) {
+        const f64 time = (f64)frame * options.timestep;
+        const auto start = std::chrono::steady_clock::now();
+
+        FrameArena::get().reset();
+
+        while (next < records.size() && records[next].time <= time) {
+          const auto& record = records[next++];
+          if (record.type == Event::Type::WindowResize) {
+            mWindow->setSize(record.width, record.height);
+          }
+          EventRecording::dispatch(record, dispatch);
+        }
+
+        mTime = (float)time;
+        dt = mTime - mLastFrameTime;
+        mLastFrameTime = mTime;
+
+        render();
+
+        // Wait for the GPU so the frame time covers the whole frame, not just command submission.
+        glFinish();
+        const auto end = std::chrono::steady_clock::now();
+        report.frameTimes.push_back(std::chrono::duration<f64>(end - start).count());
+        report.glCallsIssued  += GLState::get().getStats().issued;
+        report.glCallsSkipped += GLState::get().getStats().skipped;
+
+        mWindow->pollEvents();
+        mWindow->swapBuffers();
+      }
+
+      report.frames = (u32)report.frameTimes.size();
+      report.events = next;
+      if (report.frames != 0) {
+        std::vector<f64> sorted = report.frameTimes;
+        std::sort(sorted.begin(), sorted.end());
+
+        auto percentile = [&](f64 p) {
+          return sorted[std::min(sorted.size() - 1, (usize)(p * (f64)sorted.size()))];
+        };
+
+        for (auto frameTime : sorted) {
+          report.total += frameTime;
+        }
+        report.min  = sorted.front();
+        report.max  = sorted.back();
+        report.mean = report.total / (f64)report.frames;
+        report.p50  = percentile(0.50);
+        report.p95  = percentile(0.95);
+        report.p99  = percentile(0.99);
+      }
+      return report;
+    #endif
+  }
+
+  void ReplayReport::print() const {
+    Logger::info("Replay: %u frames, %llu events, %.3fs total", frames, (unsigned long long)events, total);
+    Logger::info(
+      "Frame time (ms): min %.3f, mean %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f",
+      min * 1000.0, mean * 1000.0, p50 * 1000.0, p95 * 1000.0, p99 * 1000.0, max * 1000.0
+    );
+    if (frames != 0) {
+      Logger::info(
+        "GL state calls per frame: %.1f issued, %.1f skipped",
+        (f64)glCallsIssued / (f64)frames, (f64)glCallsSkipped / (f64)frames
+      );
+    }
   }
 
   Widget::Handle Application::getById(std::string_view id) {
+    // An id that was never interned can't belong to any widget.
+    auto symbol = Symbol::find(id);
+    if (!symbol) {
+      return nullptr;
+    }
+
     Widget::Handle result = nullptr;
-    Widget::Visitor visitor = [&](Widget::Handle current){
-      if (current->getId() == id) {
+    Widget::Visitor visitor = [&](const Widget::Handle& current){
+      if (current->getIdSymbol() == *symbol) {
         result = current;
         return false;
       }
@@ -515,14 +810,11 @@ namespace Gui {
     }
 
     // Clear focus on all other elements
-    Widget::Visitor innerVisitor = [&](Widget::Handle other) {
-      other->mFocused = false;
-      return true;
-    };
-    root->visit(root, innerVisitor);
+    root->visit(root, mUnfocusVisitor);
 
     // Focus the element
     widget->mFocused = true;
+    widget->markDirty();
     return true;
   }
 }
@@ -4,8 +4,11 @@
 
 #include "Core/Type.hpp"
 #include "Events/KeyEvent.hpp"
+#include "Events/EventRecorder.hpp"
 #include <Renderer/CameraController.hpp>
 #include <Renderer/Renderer2D.hpp>
+#include <Renderer/FrameCapture.hpp>
+#include <Renderer/RenderCache.hpp>
 
 #include <Widget/Container.hpp>
 #include <Widget/Row.hpp>
@@ -16,6 +19,11 @@
 #include <Widget/Button.hpp>
 #include <Widget/CheckBox.hpp>
 #include <Widget/TextArea.hpp>
+#include <Widget/Plot.hpp>
+#include <Widget/ListView.hpp>
+#include <Widget/Table.hpp>
+#include <Widget/ScrollView.hpp>
+#include <Widget/WidgetTree.hpp>
 
 // Forward declare
 struct GLFWwindow;
@@ -29,34 +37,45 @@ namespace Gui {
     using EventCallback = std::function<void(const Event&)>;
 
   public:
-    static Window::Handle create(const char* title, const u32 width, const u32 height);
+    static Window::Handle create(const char* title, const u32 width, const u32 height, bool visible = true, AntiAliasing antiAliasing = AntiAliasing::None);
     DISALLOW_MOVE_AND_COPY(Window);
     ~Window();
 
     bool shouldClose();
     void setShouldClose();
     void update();
+    void pollEvents();
+    void swapBuffers();
 
     void setVSync(bool enable);
     void setEventCallback(EventCallback callback);
 
     void setTitle(const String& title);
+    void setVisible(bool visible);
 
     void setSize(u32 width, u32 height);
     inline u32 getWidth()  const { return this->data.width; }
     inline u32 getHeight() const { return this->data.height; }
     inline f32 getAspectRatio() const { return (f32)this->data.width / (f32)this->data.height; }
+    inline AntiAliasing getAntiAliasing() const { return this->data.antiAliasing; }
 
     bool isKeyPressed(Key key) const;
 
     void enableCursor(bool yes = true);
 
+    // Writes every event the window emits to a binary log, see EventRecorder.
+    bool startRecording(const String& path);
+    void stopRecording();
+    inline bool isRecording() const { return this->data.recorder != nullptr; }
+
   private:
     struct Data {
       GLFWwindow* window;
       u32 width;
       u32 height;
+      AntiAliasing antiAliasing;
       EventCallback eventCallback;
+      EventRecorder::Handle recorder;
     };
 
   private:
@@ -64,19 +83,56 @@ namespace Gui {
       : data{ data }
     {}
 
-    static void initializeWindowSystem();
+    static bool initializeWindowSystem();
     static void deinitializeWindowSystem();
 
+    static void emit(Data& data, const Event& event);
+
   private:
     Data data;
   };
 
+  struct ReplayOptions {
+    // Simulated time between frames, independent of how long a frame actually takes.
+    f32 timestep = 1.0f / 60.0f;
+
+    // Hide the window while replaying.
+    bool headless = false;
+  };
+
+  struct ReplayReport {
+    u32 frames = 0;
+    u64 events = 0;
+
+    // Wall-clock time spent on each frame, in seconds.
+    std::vector<f64> frameTimes;
+
+    f64 total = 0.0;
+    f64 min   = 0.0;
+    f64 max   = 0.0;
+    f64 mean  = 0.0;
+    f64 p50   = 0.0;
+    f64 p95   = 0.0;
+    f64 p99   = 0.0;
+
+    // OpenGL state changes over the whole replay, see GLState.
+    u64 glCallsIssued  = 0;
+    u64 glCallsSkipped = 0;
+
+    void print() const;
+  };
+
   class Application {
   public:
-    Application(std::string title, u32 widget, u32 height);
+    Application(std::string title, u32 widget, u32 height, AntiAliasing antiAliasing = AntiAliasing::None);
     virtual ~Application() {}
 
     void run();
+
+    // Replays an event log recorded with Window::startRecording, feeding the events
+    // to the application at fixed timesteps so that every run does the same work.
+    Option<ReplayReport> replay(const String& path, ReplayOptions options = {});
+
     u32 getWidth() { return mWidth; }
     u32 getHeight() { return mHeight; }
     float getTime() { return mTime; }
@@ -92,7 +148,7 @@ namespace Gui {
     template<typename T>
     std::vector<Widget::Handle> getByType() {
       std::vector<Widget::Handle> results;
-      Widget::Visitor visitor = [&](Widget::Handle current){
+      Widget::Visitor visitor = [&](const Widget::Handle& current){
         if (current->as<T>()) {
           results.push_back(current);
         }
@@ -104,8 +160,23 @@ namespace Gui {
 
     bool focus(Widget::Handle widget);
 
+    // Captures every rendered frame until stopCapture().
+    void startCapture(FrameCapture::Handle capture);
+    void stopCapture();
+
+    // Snapshot of the widget tree as of the last layout, its widget pointers
+    // are only valid until the tree changes.
+    inline const WidgetTree& getWidgetTree() const { return mWidgetTree; }
+
   public: // Don't use directly!
     void logicLoop();
+    void onEvent(const Event& event);
+
+  private:
+    void render();
+
+    // Caches the largest subtrees that haven't changed for a while, see Widget::CacheMode.
+    void cacheStableSubtrees();
 
   private:
     u32 mWidth  = 620;
@@ -115,6 +186,25 @@ namespace Gui {
     Window::Handle mWindow = nullptr;
     OrthographicCameraController mCamera;
 
+    // State for the event dispatch visitors below. They are built once so
+    // handling an event does not construct (and allocate) any std::function.
+    struct {
+      Widget::Handle focused;
+      Widget::KeyEvent keyEvent;
+
+      // Of a click or scroll, taken from the snapshot before any handler runs.
+      std::vector<Widget::Handle> targets;
+    } mDispatch;
+
+    Widget::Visitor mUnfocusVisitor;
+    Widget::Visitor mFindFocusedVisitor;
+    Widget::Visitor mKeyVisitor;
+
+    FrameCapture::Handle mCapture;
+
+    // Reused by cacheStableSubtrees().
+    std::vector<WidgetTree::Id> mCacheStack;
+
   protected:
     Renderer2D renderer;
     float dt;
@@ -123,6 +213,7 @@ namespace Gui {
     Vec2 mMousePosition;
 
     Widget::Handle root;
+    WidgetTree mWidgetTree;
   };
 
 } // namespace Gui
@@ -0,0 +1,240 @@
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "Renderer/DynamicAtlas.hpp"
+
+namespace Gui {
+
+  DynamicAtlas::Skyline::Skyline(u32 width, u32 height)
+    : mWidth{width}, mHeight{height}
+  {
+    reset();
+  }
+
+  void DynamicAtlas::Skyline::reset() {
+    mSegments.clear();
+    mSegments.push_back({0, 0, mWidth});
+  }
+
+  bool DynamicAtlas::Skyline::fits(usize index, u32 width, u32 height, u32& y) const {
+    const u32 x = mSegments[index].x;
+    if (x + width > mWidth) {
+      return false;
+    }
+
+    // The rectangle rests on the highest segment it spans.
+    y = 0;
+    i64 remaining = width;
+    for (usize i = index; remaining > 0; ++i) {
+      y = std::max(y, mSegments[i].y);
+      if (y + height > mHeight) {
+        return false;
+      }
+      remaining -= mSegments[i].width;
+    }
+    return true;
+  }
+
+  bool DynamicAtlas::Skyline::insert(u32 width, u32 height, u32& x, u32& y) {
+    usize best = mSegments.size();
+    u32 bestTop = UINT32_MAX;
+    u32 bestWidth = UINT32_MAX;
+    u32 bestY = 0;
+    for (usize i = 0; i < mSegments.size(); ++i) {
+      u32 candidate;
+      if (!fits(i, width, height, candidate)) {
+        continue;
+      }
+
+      const u32 top = candidate + height;
+      if (top < bestTop || (top == bestTop && mSegments[i].width < bestWidth)) {
+        best = i;
+        bestTop = top;
+        bestWidth = mSegments[i].width;
+        bestY = candidate;
+      }
+    }
+
+    if (best == mSegments.size()) {
+      return false;
+    }
+
+    x = mSegments[best].x;
+    y = bestY;
+    mSegments.insert(mSegments.begin() + best, {x, y + height, width});
+
+    // Cut the segments now covered by the new one.
+    for (usize i = best + 1; i < mSegments.size();) {
+      const u32 end = mSegments[i - 1].x + mSegments[i - 1].width;
+      if (mSegments[i].x >= end) {
+        break;
+      }
+
+      const u32 overlap = end - mSegments[i].x;
+      if (mSegments[i].width <= overlap) {
+        mSegments.erase(mSegments.begin() + i);
+        continue;
+      }
+      mSegments[i].x     += overlap;
+      mSegments[i].width -= overlap;
+      break;
+    }
+
+    // Merge neighbours at the same height.
+    for (usize i = 0; i + 1 < mSegments.size();) {
+      if (mSegments[i].y == mSegments[i + 1].y) {
+        mSegments[i].width += mSegments[i + 1].width;
+        mSegments.erase(mSegments.begin() + i + 1);
+      } else {
+        ++i;
+      }
+    }
+    return true;
+  }
+
+  DynamicAtlas::Handle DynamicAtlas::create(Specification specification) {
+    GUI_ASSERT(specification.pageSize != 0 && specification.maxPages != 0);
+    GUI_ASSERT(specification.maxImageSize + 2 * PADDING <= specification.pageSize);
+    return makeRef<DynamicAtlas>(specification);
+  }
+
+  DynamicAtlas::Page& DynamicAtlas::createPage() {
+    auto texture = Texture::buffer(mSpecification.pageSize, mSpecification.pageSize)
+      .format(Texture::Format::Rgba8)
+      .wrapping(Texture::WrappingMode::ClampToEdge)
+      .filtering(mSpecification.filtering)
+      .mipmap(Texture::MipmapMode::None)
+      .build();
+
+    mPages.push_back(Page{texture, Skyline(mSpecification.pageSize, mSpecification.pageSize)});
+    return mPages.back();
+  }
+
+  Option<u32> DynamicAtlas::evict() {
+    Option<u32> victim;
+    for (u32 i = 0; i < mPages.size(); ++i) {
+      // Only the atlas holds the page, so none of its images are in use.
+      if (mPages[i].texture.getRefCount() != 1) {
+        continue;
+      }
+      if (!victim || mPages[i].lastUse < mPages[*victim].lastUse) {
+        victim = i;
+      }
+    }
+
+    if (victim) {
+      auto& page = mPages[*victim];
+      page.skyline.reset();
+      page.generation++;
+      mStats.evictions++;
+
+      for (auto it = mEntries.begin(); it != mEntries.end();) {
+        if (it->second.page == *victim) {
+          it = mEntries.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    return victim;
+  }
+
+  Option<u32> DynamicAtlas::allocate(u32 width, u32 height, u32& x, u32& y) {
+    for (u32 i = 0; i < mPages.size(); ++i) {
+      if (mPages[i].skyline.insert(width, height, x, y)) {
+        return i;
+      }
+    }
+
+    if (mPages.size() < mSpecification.maxPages) {
+      createPage();
+    } else if (!evict()) {
+      return None;
+    }
+
+    // Either a new page or an empty one, try again.
+    for (u32 i = 0; i < mPages.size(); ++i) {
+      if (mPages[i].skyline.insert(width, height, x, y)) {
+        return i;
+      }
+    }
+    return None;
+  }
+
+  Option<SubTexture> DynamicAtlas::add(const void* pixels, u32 width, u32 height) {
+    if (width == 0 || height == 0 || width > mSpecification.maxImageSize || height > mSpecification.maxImageSize) {
+      return None;
+    }
+
+    const u32 paddedWidth  = width  + 2 * PADDING;
+    const u32 paddedHeight = height + 2 * PADDING;
+
+    u32 x, y;
+    auto index = allocate(paddedWidth, paddedHeight, x, y);
+    if (!index) {
+      return None;
+    }
+
+    // Copy the image into the middle of a padded buffer and extrude its edges.
+    const u32* source = (const u32*)pixels;
+    std::vector<u32> padded(paddedWidth * paddedHeight);
+    for (u32 row = 0; row < paddedHeight; ++row) {
+      const u32 sourceRow = std::min(std::max(row, PADDING) - PADDING, height - 1);
+      for (u32 column = 0; column < paddedWidth; ++column) {
+        const u32 sourceColumn = std::min(std::max(column, PADDING) - PADDING, width - 1);
+        padded[row * paddedWidth + column] = source[sourceRow * width + sourceColumn];
+      }
+    }
+
+    auto& page = mPages[*index];
+    page.texture->update(x, y, paddedWidth, paddedHeight, padded.data());
+    page.lastUse = ++mClock;
+    mStats.packed++;
+
+    const f32 size = (f32)mSpecification.pageSize;
+    const Vec2 from = {(f32)(x + PADDING) / size, (f32)(y + PADDING) / size};
+    const Vec2 to   = {(f32)(x + PADDING + width) / size, (f32)(y + PADDING + height) / size};
+    return SubTexture(page.texture, from, to);
+  }
+
+  SubTexture DynamicAtlas::load(const Asset::Handle& asset, bool verticalFlipOnLoad) {
+    const auto& path = asset->filepath();
+    if (auto it = mEntries.find(path); it != mEntries.end()) {
+      auto& page = mPages[it->second.page];
+      if (page.generation == it->second.generation) {
+        page.lastUse = ++mClock;
+        return SubTexture(page.texture, it->second.from, it->second.to);
+      }
+      mEntries.erase(it);
+    }
+
+    if (asset->load()) {
+      stbi_set_flip_vertically_on_load_thread(verticalFlipOnLoad);
+
+      int width, height, channels;
+      stbi_uc* bytes = stbi_load_from_memory(asset->data(), (int)asset->size(), &width, &height, &channels, 4);
+      if (bytes) {
+        auto result = add(bytes, (u32)width, (u32)height);
+        stbi_image_free(bytes);
+
+        if (result) {
+          const auto& texture = result->getTexture();
+          for (u32 i = 0; i < mPages.size(); ++i) {
+            if (mPages[i].texture == texture) {
+              mEntries.insert_or_assign(path, Entry{i, mPages[i].generation, result->getFrom(), result->getTo()});
+              break;
+            }
+          }
+          return *result;
+        }
+      }
+    }
+
+    // Too large, undecodable, or every page is in use: same as without an atlas.
+    mStats.fallbacks++;
+    return SubTexture(Texture::load(asset, verticalFlipOnLoad).build());
+  }
+
+} // namespace Gui
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Core/Base.hpp"
+#include "Renderer/Texture.hpp"
+
+#include <Asset.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace Gui {
+
+  // Packs small images into a few shared texture pages, so images that would
+  // each need their own texture slot can be drawn in the same batch.
+  //
+  // Images are placed with skyline bottom-left packing. When every page is
+  // full, the least recently used page that nothing references anymore (no
+  // SubTexture of it is alive outside the atlas) is cleared and reused.
+  // Images that don't fit, or that arrive while every page is in use, get
+  // their own texture.
+  class DynamicAtlas : public RefCounted {
+  public:
+    using Handle = Ref<DynamicAtlas>;
+
+    struct Specification {
+      Specification() {}
+
+      u32 pageSize     = 1024;
+      u32 maxPages     = 4;
+
+      // Larger images are not worth packing.
+      u32 maxImageSize = 256;
+
+      Texture::FilteringMode filtering = Texture::FilteringMode::Linear;
+    };
+
+    struct Stats {
+      u32 packed    = 0;
+      u32 fallbacks = 0;
+      u32 evictions = 0;
+    };
+
+  public:
+    [[nodiscard]] static DynamicAtlas::Handle create(Specification specification = {});
+    DISALLOW_MOVE_AND_COPY(DynamicAtlas);
+
+    // Same as Texture::load(asset).build(), but small images end up in a
+    // page. Loading the same asset again returns the same region.
+    SubTexture load(const Asset::Handle& asset, bool verticalFlipOnLoad = true);
+
+    // Copies tightly packed RGBA8 pixels into a page. Returns None if the
+    // image can't be packed.
+    Option<SubTexture> add(const void* pixels, u32 width, u32 height);
+
+    inline u32 getPageCount() const { return (u32)mPages.size(); }
+    inline const Texture::Handle& getPage(u32 index) const { return mPages[index].texture; }
+    inline const Specification& getSpecification() const { return mSpecification; }
+    inline const Stats& getStats() const { return mStats; }
+
+  private:
+    class Skyline {
+    public:
+      Skyline(u32 width, u32 height);
+
+      // Returns false if there's no space left for the rectangle.
+      bool insert(u32 width, u32 height, u32& x, u32& y);
+      void reset();
+
+    private:
+      struct Segment {
+        u32 x;
+        u32 y;
+        u32 width;
+      };
+
+      bool fits(usize index, u32 width, u32 height, u32& y) const;
+
+    private:
+      u32 mWidth;
+      u32 mHeight;
+      std::vector<Segment> mSegments;
+    };
+
+    struct Page {
+      Texture::Handle texture;
+      Skyline skyline;
+
+      // Bumped when the page is cleared, invalidating its cached entries.
+      u32 generation = 0;
+      u64 lastUse = 0;
+    };
+
+    struct Entry {
+      u32 page;
+      u32 generation;
+      Vec2 from;
+      Vec2 to;
+    };
+
+    // Border around each image, filled with its edge pixels so linear
+    // filtering doesn't pick up the neighbours.
+    static constexpr const u32 PADDING = 1;
+
+  public:
+    // DO NOT USE! Use DynamicAtlas::create()
+    DynamicAtlas(Specification specification)
+      : mSpecification{specification}
+    {}
+
+  private:
+    Option<u32> allocate(u32 width, u32 height, u32& x, u32& y);
+    Option<u32> evict();
+    Page& createPage();
+
+  private:
+    Specification mSpecification;
+    std::vector<Page> mPages;
+    std::unordered_map<String, Entry> mEntries;
+    u64 mClock = 0;
+    Stats mStats;
+  };
+
+} // namespace Gui
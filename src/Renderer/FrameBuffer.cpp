@@ -1,6 +1,9 @@
 #include "Core/OpenGL.hpp"
 
 #include "Renderer/FrameBuffer.hpp"
+#include "Renderer/GLState.hpp"
+
+#include <algorithm>
 
 namespace Gui {
 
@@ -19,6 +22,25 @@ namespace Gui {
 
       return openGLClear;
     }
+
+    GLenum renderBufferFormat(FrameBuffer::Attachment::Format format, usize& bytesPerPixel) {
+      using Format = FrameBuffer::Attachment::Format;
+      switch (format) {
+        case Format::Rgb8:            bytesPerPixel = 3;  return GL_RGB8;
+        case Format::Rgba8:           bytesPerPixel = 4;  return GL_RGBA8;
+        case Format::Rgba8UI:         bytesPerPixel = 4;  return GL_RGBA8UI;
+        case Format::Srgb8:           bytesPerPixel = 3;  return GL_SRGB8;
+        case Format::Srgb8Alpha8:     bytesPerPixel = 4;  return GL_SRGB8_ALPHA8;
+        case Format::Rgb32F:          bytesPerPixel = 12; return GL_RGB32F;
+        case Format::Rgba32F:         bytesPerPixel = 16; return GL_RGBA32F;
+        case Format::Rgb16F:          bytesPerPixel = 6;  return GL_RGB16F;
+        case Format::Rgba16F:         bytesPerPixel = 8;  return GL_RGBA16F;
+        case Format::R11FG11FB10F:    bytesPerPixel = 4;  return GL_R11F_G11F_B10F;
+        case Format::R32UI:           bytesPerPixel = 4;  return GL_R32UI;
+        case Format::Depth24Stencil8: bytesPerPixel = 4;  return GL_DEPTH24_STENCIL8;
+      }
+      GUI_UNREACHABLE("unknown internal format type!");
+    }
   }
 
   FrameBuffer::Builder& FrameBuffer::Builder::clearColor(f32 r, f32 g, f32 b, f32 a) {
@@ -57,6 +79,10 @@ namespace Gui {
     mDepthStencilAttachment.type = type;
     return *this;
   }
+  FrameBuffer::Builder& FrameBuffer::Builder::samples(u32 inSamples) {
+    mSamples = inSamples;
+    return *this;
+  }
   FrameBuffer::Handle FrameBuffer::Builder::build() {
     return FrameBuffer::create(*this);
   }
@@ -64,7 +90,7 @@ namespace Gui {
     return FrameBuffer::Builder(width, height);
   }
   FrameBuffer::Handle FrameBuffer::create(Builder& builder) {
-    return std::make_shared<FrameBuffer>(builder);
+    return makeRef<FrameBuffer>(builder);
   }
   FrameBuffer::FrameBuffer(Builder& builder)
     : mId{0}
@@ -75,6 +101,7 @@ namespace Gui {
     mClearOnBind = builder.mClearOnBind;
     mClear       = builder.mClear;
     mClearColor  = builder.mClearColor;
+    mSamples     = builder.mSamples;
     mAttachmentsSpecification = std::move(builder.mAttachments);
     mDepthStencilAttachmentSpecification = builder.mDepthStencilAttachment;
 
@@ -93,7 +120,7 @@ namespace Gui {
 
     // Create and bind
     glGenFramebuffers(1, &mId);
-    glBindFramebuffer(GL_FRAMEBUFFER, mId);
+    GLState::get().bindFramebuffer(GL_FRAMEBUFFER, mId);
 
     u32 drawableAttachmentsCount = 0;
     GLenum drawableAttachments[32] = {};
@@ -103,12 +130,31 @@ namespace Gui {
     for (u32 i = 0; i < mAttachmentsSpecification.size(); ++i) {
       Attachment& attachment = mAttachmentsSpecification[i];
 
+      GUI_ASSERT_WITH_MESSAGE(!attachment.isMultisample || mSamples != 0, "multisampled attachments need Builder::samples()");
+
+      if (attachment.drawable) {
+        drawableAttachments[drawableAttachmentsCount++] = GL_COLOR_ATTACHMENT0 + i;
+      }
+
+      if (mSamples != 0) {
+        usize bytesPerPixel;
+        const GLenum format = renderBufferFormat(attachment.format, bytesPerPixel);
+
+        u32 renderBuffer;
+        glGenRenderbuffers(1, &renderBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, renderBuffer);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, mSamples, format, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_RENDERBUFFER, renderBuffer);
+
+        mColorRenderBuffers.push_back(renderBuffer);
+        mColorAttachments.emplace_back();
+        mByteSize += (usize)width * height * bytesPerPixel * mSamples;
+        continue;
+      }
+
       // TODO: implement other attachment types
       GUI_ASSERT(attachment.type == Attachment::Type::Texture);
 
-      // TODO: implement multisampled attachment types
-      GUI_ASSERT(!attachment.isMultisample);
-
       // create color attachment texture
       auto texture = Texture::buffer(width, height)
         .format(attachment.format)
@@ -120,18 +166,20 @@ namespace Gui {
       // bind color attachment
       glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, texture->getId(), 0);
 
-      if (attachment.drawable) {
-        drawableAttachments[drawableAttachmentsCount++] = GL_COLOR_ATTACHMENT0 + i;
-      }
-
+      mByteSize += texture->getByteSize();
       mColorAttachments.emplace_back(std::move(texture));
     }
 
-    if (mDepthStencilAttachmentSpecification.type == Attachment::Type::RenderBuffer) {
+    if (mSamples != 0 || mDepthStencilAttachmentSpecification.type == Attachment::Type::RenderBuffer) {
       // create a renderbuffer object for depth and stencil attachment (we won't be sampling these)
       glGenRenderbuffers(1, &mDepthStencilAttachment);
       glBindRenderbuffer(GL_RENDERBUFFER, mDepthStencilAttachment);
-      glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+      if (mSamples != 0) {
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, mSamples, GL_DEPTH24_STENCIL8, width, height);
+      } else {
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+      }
+      mByteSize += (usize)width * height * 4 * std::max(mSamples, 1u);
 
       // bind depth and stencil attachment
       glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, mDepthStencilAttachment);
@@ -148,6 +196,7 @@ namespace Gui {
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);      
 
       glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, mDepthStencilTexture->getId(), 0);
+      mByteSize += mDepthStencilTexture->getByteSize();
     }
 
     GUI_ASSERT_WITH_MESSAGE(
@@ -158,14 +207,20 @@ namespace Gui {
     glDrawBuffers(drawableAttachmentsCount, drawableAttachments);
 
     // unbind framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::get().bindFramebuffer(GL_FRAMEBUFFER, 0);
   }
 
   void FrameBuffer::destroy() {
-    glDeleteFramebuffers(1, &mId);
+    GLState::get().deleteFramebuffer(mId);
     mColorAttachments.clear();
+    if (!mColorRenderBuffers.empty()) {
+      glDeleteRenderbuffers((GLsizei)mColorRenderBuffers.size(), mColorRenderBuffers.data());
+      mColorRenderBuffers.clear();
+    }
     glDeleteRenderbuffers(1, &mDepthStencilAttachment);
+    mDepthStencilAttachment = 0;
     mDepthStencilTexture = {};
+    mByteSize = 0;
   }
 
   FrameBuffer::~FrameBuffer() {
@@ -174,14 +229,14 @@ namespace Gui {
 
   void FrameBuffer::bind(bool forDraw) {
     if (forDraw) {
-      glBindFramebuffer(GL_FRAMEBUFFER, mId);
+      GLState::get().bindFramebuffer(GL_FRAMEBUFFER, mId);
       glClearColor(mClearColor.r, mClearColor.g, mClearColor.b, mClearColor.a);
 
       if (mClearOnBind) {
         this->clear();
       }
     } else {
-      glBindFramebuffer(GL_READ_FRAMEBUFFER, mId);
+      GLState::get().bindFramebuffer(GL_READ_FRAMEBUFFER, mId);
     }
   }
 
@@ -193,8 +248,14 @@ namespace Gui {
     glClear(clearToOpenGLType(clear));
   }
 
+  void FrameBuffer::resolve(u32 framebuffer) {
+    GLState::get().bindFramebuffer(GL_READ_FRAMEBUFFER, mId);
+    GLState::get().bindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+    glBlitFramebuffer(0, 0, mWidth, mHeight, 0, 0, mWidth, mHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  }
+
   void FrameBuffer::unbind() {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::get().bindFramebuffer(GL_FRAMEBUFFER, 0);
   }
 
 } // namespace Gui
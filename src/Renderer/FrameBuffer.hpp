@@ -7,9 +7,9 @@
 
 namespace Gui {
 
-  class FrameBuffer {
+  class FrameBuffer : public RefCounted {
   public:
-    using Handle = std::shared_ptr<FrameBuffer>;
+    using Handle = Ref<FrameBuffer>;
 
     enum class Clear : u8 {
       Color   = 0b0000'0001,
@@ -41,6 +41,9 @@ namespace Gui {
       Builder& attach(Attachment::Type type, Attachment::Format format, bool drawable = true, bool isMultisample = false);
       Builder& attachDefaultDepthStencilBuffer();
       Builder& depthStencilType(Attachment::Type type);
+
+      // Makes every attachment a multisampled render buffer, see resolve().
+      Builder& samples(u32 inSamples);
       FrameBuffer::Handle build();
 
     private:
@@ -55,6 +58,7 @@ namespace Gui {
       Vec4 mClearColor = {1.0f, 1.0f, 1.0f, 1.0f};
       FrameBuffer::Clear mClear = FrameBuffer::Clear::Color;
       bool mClearOnBind = true;
+      u32 mSamples = 0;
  
       std::vector<Attachment> mAttachments;
       Attachment mDepthStencilAttachment = {
@@ -80,6 +84,10 @@ namespace Gui {
     void clear();
     void clear(FrameBuffer::Clear clear);
 
+    // Blits the first color attachment into another framebuffer, 0 being the
+    // window. Multisampled framebuffers can only be read this way.
+    void resolve(u32 framebuffer = 0);
+
     inline const Texture::Handle& getColorAttachment(u32 index = 0) const {
       return mColorAttachments[index];
     }
@@ -89,11 +97,17 @@ namespace Gui {
     }
 
     inline u32 getId() const { return mId; }
+    inline u32 getWidth() const { return mWidth; }
+    inline u32 getHeight() const { return mHeight; }
+    inline u32 getSamples() const { return mSamples; }
+
+    // GPU memory of all the attachments.
+    inline usize getByteSize() const { return mByteSize; }
 
   public:
     // DO NOT USE! Use the builder!
     //
-    // NOTE: It has to be public so it can be constructed by std::make_shared.
+    // NOTE: It has to be public so it can be constructed by makeRef().
     FrameBuffer(Builder& builder);
 
   private:
@@ -113,6 +127,10 @@ namespace Gui {
     Texture::Handle mDepthStencilTexture;
     u32 mDepthStencilAttachment = 0;
 
+    u32 mSamples = 0;
+    std::vector<u32> mColorRenderBuffers;
+    usize mByteSize = 0;
+
     u32 mWidth;
     u32 mHeight;
   };
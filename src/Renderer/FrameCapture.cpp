@@ -0,0 +1,275 @@
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include "Core/OpenGL.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Renderer/FrameCapture.hpp"
+#include "Renderer/GLState.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace Gui {
+
+  namespace {
+    void flipRows(std::vector<u8>& pixels, u32 width, u32 height) {
+      const usize stride = (usize)width * 4;
+      for (u32 y = 0; y < height / 2; ++y) {
+        std::swap_ranges(
+          pixels.begin() + y * stride,
+          pixels.begin() + (y + 1) * stride,
+          pixels.begin() + (height - 1 - y) * stride
+        );
+      }
+    }
+
+    // See: https://qoiformat.org/qoi-specification.pdf
+    void encodeQoi(const FrameCapture::Frame& frame, std::vector<u8>& out) {
+      struct Pixel {
+        u8 r, g, b, a;
+
+        bool operator==(const Pixel& other) const {
+          return r == other.r && g == other.g && b == other.b && a == other.a;
+        }
+      };
+
+      auto write32 = [&](u32 value) {
+        out.push_back((u8)(value >> 24));
+        out.push_back((u8)(value >> 16));
+        out.push_back((u8)(value >> 8));
+        out.push_back((u8)(value));
+      };
+
+      const usize count = (usize)frame.width * frame.height;
+      out.clear();
+      out.reserve(14 + count + 8);
+
+      out.insert(out.end(), {'q', 'o', 'i', 'f'});
+      write32(frame.width);
+      write32(frame.height);
+      out.push_back(4); // RGBA
+      out.push_back(0); // sRGB
+
+      Pixel index[64] = {};
+      Pixel previous = {0, 0, 0, 255};
+      u32 run = 0;
+      for (usize i = 0; i < count; ++i) {
+        const u8* p = &frame.pixels[i * 4];
+        const Pixel pixel = {p[0], p[1], p[2], p[3]};
+
+        if (pixel == previous) {
+          run++;
+          if (run == 62 || i + 1 == count) {
+            out.push_back((u8)(0xC0 | (run - 1)));
+            run = 0;
+          }
+          continue;
+        }
+
+        if (run != 0) {
+          out.push_back((u8)(0xC0 | (run - 1)));
+          run = 0;
+        }
+
+        const u32 hash = (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64;
+        if (index[hash] == pixel) {
+          out.push_back((u8)hash);
+        } else {
+          index[hash] = pixel;
+
+          if (pixel.a == previous.a) {
+            const i8 dr = (i8)(pixel.r - previous.r);
+            const i8 dg = (i8)(pixel.g - previous.g);
+            const i8 db = (i8)(pixel.b - previous.b);
+            const i8 drg = (i8)(dr - dg);
+            const i8 dbg = (i8)(db - dg);
+
+            if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+              out.push_back((u8)(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+            } else if (drg > -9 && drg < 8 && dg > -33 && dg < 32 && dbg > -9 && dbg < 8) {
+              out.push_back((u8)(0x80 | (dg + 32)));
+              out.push_back((u8)((drg + 8) << 4 | (dbg + 8)));
+            } else {
+              out.insert(out.end(), {0xFE, pixel.r, pixel.g, pixel.b});
+            }
+          } else {
+            out.insert(out.end(), {0xFF, pixel.r, pixel.g, pixel.b, pixel.a});
+          }
+        }
+        previous = pixel;
+      }
+
+      out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+    }
+  }
+
+  FrameCapture::Handle FrameCapture::create(Sink sink, Specification specification) {
+    GUI_ASSERT(sink);
+    GUI_ASSERT(specification.latency != 0 && specification.maxQueuedFrames != 0);
+
+    auto capture = makeRef<FrameCapture>(std::move(sink), specification);
+    capture->mSlots.resize(specification.latency);
+    for (auto& slot : capture->mSlots) {
+      glGenBuffers(1, &slot.buffer);
+    }
+    return capture;
+  }
+
+  FrameCapture::Sink FrameCapture::writeFiles(String directory, Format format) {
+    return [directory = std::move(directory), format](const Frame& frame) {
+      char name[32];
+      std::snprintf(name, sizeof(name), "frame-%06u.%s", frame.index, format == Format::Png ? "png" : "qoi");
+      const String path = directory + "/" + name;
+
+      if (format == Format::Png) {
+        if (!stbi_write_png(path.c_str(), (int)frame.width, (int)frame.height, 4, frame.pixels.data(), (int)frame.width * 4)) {
+          Logger::error("Couldn't write frame capture '%s'", path.c_str());
+        }
+        return;
+      }
+
+      // One encode buffer per worker, so frames don't allocate once warmed up.
+      thread_local std::vector<u8> encoded;
+      encodeQoi(frame, encoded);
+
+      std::FILE* file = std::fopen(path.c_str(), "wb");
+      if (!file || std::fwrite(encoded.data(), 1, encoded.size(), file) != encoded.size()) {
+        Logger::error("Couldn't write frame capture '%s'", path.c_str());
+      }
+      if (file) {
+        std::fclose(file);
+      }
+    };
+  }
+
+  FrameCapture::FrameCapture(Sink sink, Specification specification)
+    : mSink{std::move(sink)}, mSpecification{specification}
+  {}
+
+  FrameCapture::~FrameCapture() {
+    flush();
+    for (auto& slot : mSlots) {
+      GLState::get().deleteBuffer(slot.buffer);
+    }
+  }
+
+  void FrameCapture::capture(const FrameBuffer::Handle& framebuffer) {
+    capture(framebuffer->getId(), framebuffer->getWidth(), framebuffer->getHeight());
+  }
+
+  void FrameCapture::capture(u32 framebuffer, u32 width, u32 height) {
+    auto& slot = mSlots[mNext];
+
+    // The oldest readback, issued `latency` captures ago. When it can't be
+    // waited for, this frame is dropped and the slot tried again next time.
+    if (slot.fence && !read(slot, false)) {
+      mStats.dropped++;
+      return;
+    }
+    mNext = (mNext + 1) % (u32)mSlots.size();
+
+    const usize size = (usize)width * height * 4;
+    GLState::get().bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if (slot.size != size) {
+      glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+      slot.size = size;
+    }
+
+    GLState::get().bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    GLState::get().bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence  = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.index  = mFrameIndex++;
+    slot.width  = width;
+    slot.height = height;
+    mStats.captured++;
+  }
+
+  bool FrameCapture::read(Slot& slot, bool block) {
+    auto fence = (GLsync)slot.fence;
+    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+      mStats.stalls++;
+      #ifdef GUI_PLATFORM_WEB
+        // WebGL only allows a zero timeout and signals fences between frames,
+        // so waiting here would never end. glGetBufferSubData() waits for the
+        // readback itself, which only flush() may afford.
+        if (!block) {
+          return false;
+        }
+      #else
+        (void)block;
+        do {
+          result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+        } while (result == GL_TIMEOUT_EXPIRED);
+      #endif
+    }
+    glDeleteSync(fence);
+    slot.fence = nullptr;
+
+    if (result == GL_WAIT_FAILED) {
+      Logger::error("Couldn't wait for the readback of captured frame %u", slot.index);
+      mStats.dropped++;
+      return true;
+    }
+
+    Frame frame = {slot.index, slot.width, slot.height, {}};
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (mQueued == mSpecification.maxQueuedFrames) {
+        mStats.dropped++;
+        return true;
+      }
+      mQueued++;
+
+      if (!mFreePixels.empty()) {
+        frame.pixels = std::move(mFreePixels.back());
+        mFreePixels.pop_back();
+      }
+    }
+    frame.pixels.resize(slot.size);
+
+    GLState::get().bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    #ifdef GUI_PLATFORM_WEB
+      // WebGL can't map buffers.
+      glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, slot.size, frame.pixels.data());
+    #else
+      const void* mapping = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.size, GL_MAP_READ_BIT);
+      std::memcpy(frame.pixels.data(), mapping, slot.size);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    #endif
+    GLState::get().bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    // The worker only touches the sink and the queue, never the reference count.
+    ThreadPool::get().submit([this, frame = std::move(frame)]() mutable {
+      // OpenGL rows start at the bottom.
+      flipRows(frame.pixels, frame.width, frame.height);
+      mSink(frame);
+
+      std::lock_guard<std::mutex> lock(mMutex);
+      mFreePixels.push_back(std::move(frame.pixels));
+      mQueued--;
+      mCondition.notify_all();
+    });
+    return true;
+  }
+
+  void FrameCapture::flush() {
+    for (u32 i = 0; i < mSlots.size(); ++i) {
+      auto& slot = mSlots[(mNext + i) % mSlots.size()];
+      if (slot.fence) {
+        read(slot, true);
+      }
+    }
+    waitForSink();
+  }
+
+  void FrameCapture::waitForSink() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this] { return mQueued == 0; });
+  }
+
+} // namespace Gui
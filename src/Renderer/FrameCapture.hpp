@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Core/Base.hpp"
+#include "Renderer/FrameBuffer.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Gui {
+
+  // Reads frames back from a framebuffer without waiting for the GPU.
+  //
+  // capture() issues a glReadPixels() into one of `latency` pixel pack
+  // buffers and fences it. The buffer is only mapped when the ring comes
+  // back around to it, `latency` captures later, by which time the GPU is
+  // long done with it. The pixels are then handed to the sink on the
+  // ThreadPool, so encoding never runs on the render thread.
+  //
+  // At most `maxQueuedFrames` frames wait for the sink, when it can't keep up
+  // further frames are dropped, which bounds the memory used.
+  class FrameCapture : public RefCounted {
+  public:
+    using Handle = Ref<FrameCapture>;
+
+    struct Frame {
+      u32 index;
+      u32 width;
+      u32 height;
+
+      // Tightly packed RGBA8, top row first.
+      std::vector<u8> pixels;
+    };
+
+    // Called on a worker thread, possibly on several frames at once.
+    using Sink = std::function<void(const Frame& frame)>;
+
+    enum class Format : u8 {
+      Png,
+
+      // Much faster to encode than PNG, keeps up with 1080p60 on one core.
+      Qoi,
+    };
+
+    struct Specification {
+      Specification() {}
+
+      u32 latency         = 3;
+      u32 maxQueuedFrames = 8;
+    };
+
+    struct Stats {
+      u32 captured = 0;
+      u32 dropped  = 0;
+
+      // Captures whose oldest readback wasn't finished yet. On the web the
+      // capture is then dropped instead of waiting.
+      u32 stalls   = 0;
+    };
+
+  public:
+    [[nodiscard]] static FrameCapture::Handle create(Sink sink, Specification specification = {});
+
+    // Sink writing every frame to `directory`/frame-000000.png (or .qoi).
+    [[nodiscard]] static Sink writeFiles(String directory, Format format = Format::Qoi);
+
+    DISALLOW_MOVE_AND_COPY(FrameCapture);
+
+    // Waits for every captured frame to reach the sink.
+    ~FrameCapture();
+
+    // Reads the current content of the framebuffer, 0 being the window.
+    void capture(u32 framebuffer, u32 width, u32 height);
+    void capture(const FrameBuffer::Handle& framebuffer);
+
+    // Hands every in flight frame to the sink and waits for it to finish.
+    void flush();
+
+    inline const Stats& getStats() const { return mStats; }
+    inline const Specification& getSpecification() const { return mSpecification; }
+
+  public:
+    // DO NOT USE! Use FrameCapture::create()
+    //
+    // NOTE: It has to be public so it can be constructed by makeRef().
+    FrameCapture(Sink sink, Specification specification);
+
+  private:
+    struct Slot {
+      u32 buffer = 0;
+      usize size = 0;
+
+      // GLsync of the readback, null if the slot holds no frame.
+      void* fence = nullptr;
+      u32 index   = 0;
+      u32 width   = 0;
+      u32 height  = 0;
+    };
+
+    // Hands the frame in the slot to the sink and frees the slot. Returns false,
+    // keeping the frame, if it isn't read back yet and can't be waited for
+    // without `block`.
+    bool read(Slot& slot, bool block);
+    void waitForSink();
+
+  private:
+    Sink mSink;
+    Specification mSpecification;
+
+    std::vector<Slot> mSlots;
+    u32 mNext = 0;
+    u32 mFrameIndex = 0;
+
+    // Frames handed to the ThreadPool and not yet through the sink, and their
+    // pixel storage once they are, for reuse.
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    u32 mQueued = 0;
+    std::vector<std::vector<u8>> mFreePixels;
+
+    Stats mStats;
+  };
+
+} // namespace Gui
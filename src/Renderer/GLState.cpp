@@ -0,0 +1,256 @@
+#include "Core/OpenGL.hpp"
+#include "Renderer/GLState.hpp"
+
+namespace Gui {
+
+  GLState& GLState::get() {
+    static GLState state;
+    return state;
+  }
+
+  GLState::GLState() {
+    invalidate();
+  }
+
+  void GLState::invalidate() {
+    mProgram            = UNKNOWN;
+    mVertexArray        = UNKNOWN;
+    mArrayBuffer        = UNKNOWN;
+    mElementArrayBuffer = UNKNOWN;
+    mUniformBuffer      = UNKNOWN;
+    mPixelPackBuffer    = UNKNOWN;
+    mPixelUnpackBuffer  = UNKNOWN;
+    mDrawFramebuffer    = UNKNOWN;
+    mReadFramebuffer    = UNKNOWN;
+    mActiveTextureUnit  = UNKNOWN;
+    for (auto& unit : mTextures) {
+      unit.fill(UNKNOWN);
+    }
+    mBlending         = UNKNOWN;
+    mBlendSource      = UNKNOWN;
+    mBlendDestination = UNKNOWN;
+    mBlendSourceAlpha      = UNKNOWN;
+    mBlendDestinationAlpha = UNKNOWN;
+    mScissorTest      = UNKNOWN;
+    mViewport = None;
+    mScissor  = None;
+  }
+
+  void GLState::beginFrame() {
+    mStats = {};
+  }
+
+  void GLState::useProgram(u32 program) {
+    if (update(mProgram, program)) {
+      glUseProgram(program);
+    }
+  }
+
+  void GLState::bindVertexArray(u32 vertexArray) {
+    if (update(mVertexArray, vertexArray)) {
+      glBindVertexArray(vertexArray);
+
+      // The element array buffer binding is part of the vertex array.
+      mElementArrayBuffer = UNKNOWN;
+    }
+  }
+
+  void GLState::bindBuffer(u32 target, u32 buffer) {
+    u32* current = nullptr;
+    switch (target) {
+      case GL_ARRAY_BUFFER:         current = &mArrayBuffer;        break;
+      case GL_ELEMENT_ARRAY_BUFFER: current = &mElementArrayBuffer; break;
+      case GL_UNIFORM_BUFFER:       current = &mUniformBuffer;      break;
+      case GL_PIXEL_PACK_BUFFER:    current = &mPixelPackBuffer;    break;
+      case GL_PIXEL_UNPACK_BUFFER:  current = &mPixelUnpackBuffer;  break;
+    }
+
+    if (!current || update(*current, buffer)) {
+      glBindBuffer(target, buffer);
+    }
+  }
+
+  void GLState::bindBufferBase(u32 target, u32 index, u32 buffer) {
+    // Also binds the buffer to the generic binding point.
+    glBindBufferBase(target, index, buffer);
+    mStats.issued++;
+    if (target == GL_UNIFORM_BUFFER) {
+      mUniformBuffer = buffer;
+    }
+  }
+
+  void GLState::activeTexture(u32 unit) {
+    GUI_DEBUG_ASSERT(unit < MAX_TEXTURE_UNITS);
+    if (update(mActiveTextureUnit, unit)) {
+      glActiveTexture(GL_TEXTURE0 + unit);
+    }
+  }
+
+  void GLState::bindTexture(u32 unit, u32 target, u32 texture) {
+    GUI_DEBUG_ASSERT(unit < MAX_TEXTURE_UNITS);
+
+    u32* current = nullptr;
+    switch (target) {
+      case GL_TEXTURE_2D:       current = &mTextures[unit][Texture2D];      break;
+      case GL_TEXTURE_2D_ARRAY: current = &mTextures[unit][Texture2DArray]; break;
+      #ifndef GUI_PLATFORM_WEB
+        case GL_TEXTURE_2D_MULTISAMPLE: current = &mTextures[unit][Texture2DMultisample]; break;
+      #endif
+    }
+
+    // Always made active, callers edit the texture through the unit they bound it to.
+    activeTexture(unit);
+    if (current && *current == texture) {
+      mStats.skipped++;
+      return;
+    }
+
+    glBindTexture(target, texture);
+    mStats.issued++;
+    if (current) {
+      *current = texture;
+    }
+  }
+
+  void GLState::bindFramebuffer(u32 target, u32 framebuffer) {
+    switch (target) {
+      case GL_FRAMEBUFFER:
+        if (mDrawFramebuffer == framebuffer && mReadFramebuffer == framebuffer) {
+          mStats.skipped++;
+          return;
+        }
+        mDrawFramebuffer = framebuffer;
+        mReadFramebuffer = framebuffer;
+        break;
+      case GL_DRAW_FRAMEBUFFER:
+        if (!update(mDrawFramebuffer, framebuffer)) {
+          return;
+        }
+        glBindFramebuffer(target, framebuffer);
+        return;
+      case GL_READ_FRAMEBUFFER:
+        if (!update(mReadFramebuffer, framebuffer)) {
+          return;
+        }
+        glBindFramebuffer(target, framebuffer);
+        return;
+    }
+
+    glBindFramebuffer(target, framebuffer);
+    mStats.issued++;
+  }
+
+  void GLState::blending(bool enabled) {
+    if (update(mBlending, enabled ? 1 : 0)) {
+      if (enabled) {
+        glEnable(GL_BLEND);
+      } else {
+        glDisable(GL_BLEND);
+      }
+    }
+  }
+
+  void GLState::blendFunc(u32 source, u32 destination) {
+    if (mBlendSource == source && mBlendDestination == destination && mBlendSourceAlpha == source && mBlendDestinationAlpha == destination) {
+      mStats.skipped++;
+      return;
+    }
+    mBlendSource           = source;
+    mBlendDestination      = destination;
+    mBlendSourceAlpha      = source;
+    mBlendDestinationAlpha = destination;
+    glBlendFunc(source, destination);
+    mStats.issued++;
+  }
+
+  void GLState::blendFuncSeparate(u32 source, u32 destination, u32 sourceAlpha, u32 destinationAlpha) {
+    if (mBlendSource == source && mBlendDestination == destination && mBlendSourceAlpha == sourceAlpha && mBlendDestinationAlpha == destinationAlpha) {
+      mStats.skipped++;
+      return;
+    }
+    mBlendSource           = source;
+    mBlendDestination      = destination;
+    mBlendSourceAlpha      = sourceAlpha;
+    mBlendDestinationAlpha = destinationAlpha;
+    glBlendFuncSeparate(source, destination, sourceAlpha, destinationAlpha);
+    mStats.issued++;
+  }
+
+  void GLState::viewport(i32 x, i32 y, i32 width, i32 height) {
+    Rect rect = {x, y, width, height};
+    if (mViewport == rect) {
+      mStats.skipped++;
+      return;
+    }
+    mViewport = rect;
+    glViewport(x, y, width, height);
+    mStats.issued++;
+  }
+
+  void GLState::scissorTest(bool enabled) {
+    if (update(mScissorTest, enabled ? 1 : 0)) {
+      if (enabled) {
+        glEnable(GL_SCISSOR_TEST);
+      } else {
+        glDisable(GL_SCISSOR_TEST);
+      }
+    }
+  }
+
+  void GLState::scissor(i32 x, i32 y, i32 width, i32 height) {
+    Rect rect = {x, y, width, height};
+    if (mScissor == rect) {
+      mStats.skipped++;
+      return;
+    }
+    mScissor = rect;
+    glScissor(x, y, width, height);
+    mStats.issued++;
+  }
+
+  void GLState::deleteProgram(u32 program) {
+    glDeleteProgram(program);
+    if (mProgram == program) {
+      mProgram = UNKNOWN;
+    }
+  }
+
+  void GLState::deleteVertexArray(u32 vertexArray) {
+    glDeleteVertexArrays(1, &vertexArray);
+    if (mVertexArray == vertexArray) {
+      mVertexArray        = 0;
+      mElementArrayBuffer = UNKNOWN;
+    }
+  }
+
+  void GLState::deleteBuffer(u32 buffer) {
+    glDeleteBuffers(1, &buffer);
+    for (auto current : {&mArrayBuffer, &mElementArrayBuffer, &mUniformBuffer, &mPixelPackBuffer, &mPixelUnpackBuffer}) {
+      if (*current == buffer) {
+        *current = 0;
+      }
+    }
+  }
+
+  void GLState::deleteTexture(u32 texture) {
+    glDeleteTextures(1, &texture);
+    for (auto& unit : mTextures) {
+      for (auto& current : unit) {
+        if (current == texture) {
+          current = 0;
+        }
+      }
+    }
+  }
+
+  void GLState::deleteFramebuffer(u32 framebuffer) {
+    glDeleteFramebuffers(1, &framebuffer);
+    if (mDrawFramebuffer == framebuffer) {
+      mDrawFramebuffer = 0;
+    }
+    if (mReadFramebuffer == framebuffer) {
+      mReadFramebuffer = 0;
+    }
+  }
+
+} // namespace Gui
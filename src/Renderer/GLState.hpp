@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Core/Base.hpp"
+
+#include <array>
+
+namespace Gui {
+
+  // Shadow copy of the OpenGL state the renderer changes. Every Renderer/*
+  // class binds through here, so calls that would not change anything are
+  // skipped.
+  //
+  // Targets and enums are the raw OpenGL values, to keep the GL headers out
+  // of this one. Code that changes this state directly must call invalidate().
+  class GLState {
+  public:
+    static constexpr const u32 MAX_TEXTURE_UNITS = 32;
+
+    struct Stats {
+      u32 issued  = 0;
+      u32 skipped = 0;
+    };
+
+  public:
+    static GLState& get();
+    DISALLOW_MOVE_AND_COPY(GLState);
+
+    void useProgram(u32 program);
+    void bindVertexArray(u32 vertexArray);
+
+    // GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_PIXEL_PACK_BUFFER or
+    // GL_PIXEL_UNPACK_BUFFER, others are passed through.
+    void bindBuffer(u32 target, u32 buffer);
+    void bindBufferBase(u32 target, u32 index, u32 buffer);
+
+    void activeTexture(u32 unit);
+
+    // Also makes `unit` the active one, even when the texture is already bound
+    // to it, so the texture can be edited right after.
+    void bindTexture(u32 unit, u32 target, u32 texture);
+
+    // GL_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER.
+    void bindFramebuffer(u32 target, u32 framebuffer);
+
+    void blending(bool enabled);
+    void blendFunc(u32 source, u32 destination);
+    void blendFuncSeparate(u32 source, u32 destination, u32 sourceAlpha, u32 destinationAlpha);
+
+    void viewport(i32 x, i32 y, i32 width, i32 height);
+    void scissorTest(bool enabled);
+    void scissor(i32 x, i32 y, i32 width, i32 height);
+
+    // Drop the shadowed bindings of deleted objects.
+    void deleteProgram(u32 program);
+    void deleteVertexArray(u32 vertexArray);
+    void deleteBuffer(u32 buffer);
+    void deleteTexture(u32 texture);
+    void deleteFramebuffer(u32 framebuffer);
+
+    // Forget everything, the next call of each kind is always issued.
+    void invalidate();
+
+    // Counts of the calls issued and skipped since the last beginFrame().
+    inline const Stats& getStats() const { return mStats; }
+    void beginFrame();
+
+  private:
+    GLState();
+
+    // Returns true if the call should be issued.
+    inline bool update(u32& current, u32 value) {
+      if (current == value) {
+        mStats.skipped++;
+        return false;
+      }
+      current = value;
+      mStats.issued++;
+      return true;
+    }
+
+  private:
+    static constexpr const u32 UNKNOWN = UINT32_MAX;
+
+    enum TextureTarget : u8 {
+      Texture2D,
+      Texture2DArray,
+      Texture2DMultisample,
+
+      TextureTargetCount,
+    };
+
+    struct Rect {
+      i32 x, y, width, height;
+
+      bool operator==(const Rect& other) const {
+        return x == other.x && y == other.y && width == other.width && height == other.height;
+      }
+    };
+
+    u32 mProgram;
+    u32 mVertexArray;
+    u32 mArrayBuffer;
+    u32 mElementArrayBuffer;
+    u32 mUniformBuffer;
+    u32 mPixelPackBuffer;
+    u32 mPixelUnpackBuffer;
+    u32 mDrawFramebuffer;
+    u32 mReadFramebuffer;
+
+    u32 mActiveTextureUnit;
+    std::array<std::array<u32, TextureTargetCount>, MAX_TEXTURE_UNITS> mTextures;
+
+    u32 mBlending;
+    u32 mBlendSource;
+    u32 mBlendDestination;
+    u32 mBlendSourceAlpha;
+    u32 mBlendDestinationAlpha;
+    u32 mScissorTest;
+    Option<Rect> mViewport;
+    Option<Rect> mScissor;
+
+    Stats mStats;
+  };
+
+} // namespace Gui
@@ -4,9 +4,9 @@
 
 namespace Gui {
 
-  class IndexBuffer {
+  class IndexBuffer : public RefCounted {
   public:
-    using Handle = std::shared_ptr<IndexBuffer>;
+    using Handle = Ref<IndexBuffer>;
 
   public:
     [[nodiscard]] static IndexBuffer::Handle create(Slice<const u32> slice);
@@ -22,7 +22,7 @@ namespace Gui {
   public:
     // DO NOT USE! Use the builder!
     //
-    // NOTE: It has to be public so it can be constructed by std::make_shared.
+    // NOTE: It has to be public so it can be constructed by makeRef().
     IndexBuffer(u32 id, u32 count)
       : id{id}, count{count}
     {}
@@ -0,0 +1,338 @@
+#include "Renderer/Path.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Gui {
+
+  namespace {
+    constexpr const f32 PI = 3.14159265358979f;
+
+    // Width of the anti-aliased fringe around fills.
+    constexpr const f32 FRINGE = 1.0f;
+
+    f32 cross(const Vec2& a, const Vec2& b) {
+      return a.x * b.y - a.y * b.x;
+    }
+
+    Vec2 rotate(const Vec2& v, f32 angle) {
+      const f32 c = std::cos(angle);
+      const f32 s = std::sin(angle);
+      return Vec2{v.x * c - v.y * s, v.x * s + v.y * c};
+    }
+
+    Vec2 direction(const Vec2& from, const Vec2& to) {
+      const Vec2 delta = to - from;
+      const f32 length = glm::length(delta);
+      return length > 0.0f ? delta / length : Vec2{1.0f, 0.0f};
+    }
+
+    // Wang's formula, `deviation` being the largest second difference of the
+    // control points already scaled for the degree of the curve.
+    u32 segmentCount(f32 deviation) {
+      const f32 count = std::ceil(std::sqrt(deviation / Path::TOLERANCE));
+      return (u32)glm::clamp(count, 1.0f, 1024.0f);
+    }
+
+    void pushTriangle(Path::Mesh& mesh, const Path::Vertex& a, const Path::Vertex& b, const Path::Vertex& c) {
+      mesh.push_back(a);
+      mesh.push_back(b);
+      mesh.push_back(c);
+    }
+
+    // Fan around `center` from `center + offset`, turning by `angle`.
+    void pushArc(Path::Mesh& mesh, const Vec2& center, const Vec2& offset, f32 angle, f32 halfWidth) {
+      const f32 radius = glm::length(offset);
+      const f32 step = 2.0f * std::acos(glm::clamp(1.0f - Path::TOLERANCE / radius, -1.0f, 1.0f));
+      const u32 steps = (u32)glm::clamp(std::ceil(glm::abs(angle) / glm::max(step, 0.01f)), 1.0f, 128.0f);
+
+      const Path::Vertex middle = {center, {0.0f, halfWidth}};
+      Vec2 previous = offset;
+      for (u32 i = 1; i <= steps; ++i) {
+        const Vec2 next = rotate(offset, angle * (f32)i / (f32)steps);
+        pushTriangle(mesh, middle, {center + previous, {radius, halfWidth}}, {center + next, {radius, halfWidth}});
+        previous = next;
+      }
+    }
+
+    void pushJoin(Path::Mesh& mesh, const Path::Stroke& stroke, const Vec2& point, const Vec2& in, const Vec2& out, f32 extent, f32 halfWidth) {
+      const f32 turn = cross(in, out);
+      if (glm::abs(turn) < 1e-6f && glm::dot(in, out) > 0.0f) {
+        return;
+      }
+
+      // The gap between the two segments is on the outside of the turn.
+      const f32 side = turn > 0.0f ? -1.0f : 1.0f;
+      const Vec2 outer0 = Vec2{-in.y,  in.x}  * side;
+      const Vec2 outer1 = Vec2{-out.y, out.x} * side;
+
+      const Path::Vertex middle = {point, {0.0f, halfWidth}};
+      const Path::Vertex from   = {point + outer0 * extent, {extent, halfWidth}};
+      const Path::Vertex to     = {point + outer1 * extent, {extent, halfWidth}};
+
+      switch (stroke.join) {
+        case Path::Join::Miter: {
+          const Vec2 bisector = outer0 + outer1;
+          const f32 length = glm::length(bisector);
+          if (length > 1e-6f) {
+            // 1 / cos(half the angle between the normals), the miter length relative to the width.
+            const f32 ratio = 2.0f / length;
+            if (ratio <= stroke.miterLimit) {
+              const Path::Vertex tip = {point + bisector / length * (extent * ratio), {extent, halfWidth}};
+              pushTriangle(mesh, middle, from, tip);
+              pushTriangle(mesh, middle, tip, to);
+              return;
+            }
+          }
+          pushTriangle(mesh, middle, from, to);
+          break;
+        }
+        case Path::Join::Round:
+          pushArc(mesh, point, outer0 * extent, std::atan2(cross(outer0, outer1), glm::dot(outer0, outer1)), halfWidth);
+          break;
+        case Path::Join::Bevel:
+          pushTriangle(mesh, middle, from, to);
+          break;
+      }
+    }
+
+    void strokeContour(Path::Mesh& mesh, const Path::Stroke& stroke, const Path::Contour& contour) {
+      std::vector<Vec2> points = contour.points;
+      if (contour.closed && points.size() > 2 && points.front() == points.back()) {
+        points.pop_back();
+      }
+
+      const usize count = points.size();
+      if (count < 2) {
+        return;
+      }
+
+      const bool closed = contour.closed && count > 2;
+      const f32 halfWidth = stroke.width / 2.0f;
+      const f32 extent = halfWidth + 0.5f;
+
+      if (!closed && stroke.cap == Path::Cap::Square) {
+        points.front() -= direction(points[0], points[1]) * halfWidth;
+        points.back()  += direction(points[count - 2], points[count - 1]) * halfWidth;
+      }
+
+      const usize segments = closed ? count : count - 1;
+      for (usize i = 0; i < segments; ++i) {
+        const Vec2& a = points[i];
+        const Vec2& b = points[(i + 1) % count];
+        const Vec2 d = direction(a, b);
+        const Vec2 normal = Vec2{-d.y, d.x} * extent;
+
+        const Path::Vertex a0 = {a + normal, { extent, halfWidth}};
+        const Path::Vertex a1 = {a - normal, {-extent, halfWidth}};
+        const Path::Vertex b0 = {b + normal, { extent, halfWidth}};
+        const Path::Vertex b1 = {b - normal, {-extent, halfWidth}};
+        pushTriangle(mesh, a0, b0, b1);
+        pushTriangle(mesh, a0, b1, a1);
+
+        if (i + 1 < segments || closed) {
+          const Vec2& c = points[(i + 2) % count];
+          pushJoin(mesh, stroke, b, d, direction(b, c), extent, halfWidth);
+        }
+      }
+
+      if (!closed && stroke.cap == Path::Cap::Round) {
+        const Vec2 first = direction(points[0], points[1]);
+        const Vec2 last  = direction(points[count - 2], points[count - 1]);
+        pushArc(mesh, points[0],         Vec2{-first.y, first.x} * extent, PI, halfWidth);
+        pushArc(mesh, points[count - 1], Vec2{last.y, -last.x}   * extent, PI, halfWidth);
+      }
+    }
+
+    bool containsPoint(const Vec2& p, const Vec2& a, const Vec2& b, const Vec2& c) {
+      return cross(b - a, p - a) >= 0.0f && cross(c - b, p - b) >= 0.0f && cross(a - c, p - c) >= 0.0f;
+    }
+
+    // Ear clipping, O(n^2).
+    void fillContour(Path::Mesh& mesh, const Path::Contour& contour) {
+      std::vector<Vec2> points = contour.points;
+      if (points.size() > 2 && points.front() == points.back()) {
+        points.pop_back();
+      }
+      if (points.size() < 3) {
+        return;
+      }
+
+      f32 area = 0.0f;
+      for (usize i = 0; i < points.size(); ++i) {
+        area += cross(points[i], points[(i + 1) % points.size()]);
+      }
+      if (glm::abs(area) < 1e-6f) {
+        return;
+      }
+      if (area < 0.0f) {
+        std::reverse(points.begin(), points.end());
+      }
+
+      const Vec2 inner = {0.0f, 0.5f};
+      std::vector<u32> remaining(points.size());
+      for (u32 i = 0; i < remaining.size(); ++i) {
+        remaining[i] = i;
+      }
+
+      usize i = 0;
+      usize attempts = 0;
+      while (remaining.size() > 3) {
+        const usize size = remaining.size();
+        const Vec2& a = points[remaining[(i + size - 1) % size]];
+        const Vec2& b = points[remaining[i]];
+        const Vec2& c = points[remaining[(i + 1) % size]];
+
+        bool ear = cross(b - a, c - b) > 0.0f;
+        for (usize j = 0; ear && j < size; ++j) {
+          const Vec2& p = points[remaining[j]];
+          if (p != a && p != b && p != c && containsPoint(p, a, b, c)) {
+            ear = false;
+          }
+        }
+
+        // Degenerate polygons have no ears left, clip anyway so it terminates.
+        if (ear || attempts > size) {
+          pushTriangle(mesh, {a, inner}, {b, inner}, {c, inner});
+          remaining.erase(remaining.begin() + i);
+          i %= remaining.size();
+          attempts = 0;
+        } else {
+          i = (i + 1) % size;
+          attempts++;
+        }
+      }
+      pushTriangle(mesh, {points[remaining[0]], inner}, {points[remaining[1]], inner}, {points[remaining[2]], inner});
+
+      // Fades out over a pixel outside the edges.
+      const Vec2 outer = {FRINGE, 0.5f};
+      const usize count = points.size();
+      for (usize j = 0; j < count; ++j) {
+        const Vec2& a = points[j];
+        const Vec2& b = points[(j + 1) % count];
+        const Vec2& c = points[(j + 2) % count];
+        const Vec2 d0 = direction(a, b);
+        const Vec2 d1 = direction(b, c);
+        const Vec2 n0 = Vec2{d0.y, -d0.x} * FRINGE;
+        const Vec2 n1 = Vec2{d1.y, -d1.x} * FRINGE;
+
+        pushTriangle(mesh, {a, inner}, {b, inner}, {b + n0, outer});
+        pushTriangle(mesh, {a, inner}, {b + n0, outer}, {a + n0, outer});
+        pushTriangle(mesh, {b, inner}, {b + n0, outer}, {b + n1, outer});
+      }
+    }
+  }
+
+  Path& Path::moveTo(const Vec2& point) {
+    if (mOpen && mContours.back().points.size() == 1) {
+      mContours.back().points[0] = point;
+    } else {
+      mContours.push_back({{point}, false});
+      mPointCount++;
+    }
+    mOpen = true;
+    changed();
+    return *this;
+  }
+
+  Path& Path::lineTo(const Vec2& point) {
+    auto& points = current().points;
+    if (points.back() != point) {
+      points.push_back(point);
+      mPointCount++;
+      changed();
+    }
+    return *this;
+  }
+
+  Path& Path::quadraticTo(const Vec2& control, const Vec2& point) {
+    auto& points = current().points;
+    const Vec2 start = points.back();
+
+    const u32 segments = segmentCount(glm::length(start - control * 2.0f + point) / 4.0f);
+    for (u32 i = 1; i <= segments; ++i) {
+      const f32 t = (f32)i / (f32)segments;
+      const f32 u = 1.0f - t;
+      points.push_back(start * (u * u) + control * (2.0f * u * t) + point * (t * t));
+    }
+    mPointCount += segments;
+    changed();
+    return *this;
+  }
+
+  Path& Path::cubicTo(const Vec2& control1, const Vec2& control2, const Vec2& point) {
+    auto& points = current().points;
+    const Vec2 start = points.back();
+
+    const f32 deviation = glm::max(
+      glm::length(start - control1 * 2.0f + control2),
+      glm::length(control1 - control2 * 2.0f + point)
+    );
+    const u32 segments = segmentCount(deviation * 3.0f / 4.0f);
+    for (u32 i = 1; i <= segments; ++i) {
+      const f32 t = (f32)i / (f32)segments;
+      const f32 u = 1.0f - t;
+      points.push_back(start * (u * u * u) + control1 * (3.0f * u * u * t) + control2 * (3.0f * u * t * t) + point * (t * t * t));
+    }
+    mPointCount += segments;
+    changed();
+    return *this;
+  }
+
+  Path& Path::close() {
+    if (mOpen) {
+      mContours.back().closed = true;
+      mOpen = false;
+      changed();
+    }
+    return *this;
+  }
+
+  void Path::clear() {
+    mContours.clear();
+    mPointCount = 0;
+    mOpen = false;
+    changed();
+  }
+
+  Path::Contour& Path::current() {
+    if (!mOpen) {
+      // After close() the path continues from the start of the closed subpath.
+      moveTo(mContours.empty() ? Vec2{0.0f} : mContours.back().points.front());
+    }
+    return mContours.back();
+  }
+
+  void Path::changed() {
+    mStrokeValid = false;
+    mFillValid = false;
+  }
+
+  const Path::Mesh& Path::getStroke(const Stroke& stroke) const {
+    if (mStrokeValid && mStrokeStyle == stroke) {
+      return mStrokeMesh;
+    }
+
+    mStrokeMesh.clear();
+    for (const auto& contour : mContours) {
+      strokeContour(mStrokeMesh, stroke, contour);
+    }
+    mStrokeStyle = stroke;
+    mStrokeValid = true;
+    return mStrokeMesh;
+  }
+
+  const Path::Mesh& Path::getFill() const {
+    if (mFillValid) {
+      return mFillMesh;
+    }
+
+    mFillMesh.clear();
+    for (const auto& contour : mContours) {
+      fillContour(mFillMesh, contour);
+    }
+    mFillValid = true;
+    return mFillMesh;
+  }
+
+} // namespace Gui
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Core/Base.hpp"
+
+#include <vector>
+
+namespace Gui {
+
+  // Lines, quadratic and cubic Bézier curves, drawn by Renderer2D::drawPath()
+  // and fillPath().
+  //
+  // Curves are flattened into polylines and tessellated into triangles on the
+  // CPU the first time the path is drawn, then the triangles are reused every
+  // frame until the path is changed. Keep the path around between frames
+  // rather than rebuilding it, otherwise it is tessellated every time.
+  //
+  // Positions are in the same units as the camera, the tessellation assumes a
+  // unit is about a pixel.
+  class Path {
+  public:
+    enum class Join : u8 {
+      Miter,
+      Round,
+      Bevel,
+    };
+
+    enum class Cap : u8 {
+      Butt,
+      Round,
+      Square,
+    };
+
+    struct Stroke {
+      f32  width = 1.0f;
+      Join join  = Join::Miter;
+      Cap  cap   = Cap::Butt;
+
+      // Longest miter, in multiples of the width, before it is beveled.
+      f32  miterLimit = 4.0f;
+
+      bool operator==(const Stroke& other) const {
+        return width == other.width && join == other.join && cap == other.cap && miterLimit == other.miterLimit;
+      }
+    };
+
+    // Triangle list. `edge` is the distance from the middle of the line, and
+    // half its width, used by the shader to anti-alias the edges.
+    struct Vertex {
+      Vec2 position;
+      Vec2 edge;
+    };
+    using Mesh = std::vector<Vertex>;
+
+    // A flattened subpath.
+    struct Contour {
+      std::vector<Vec2> points;
+      bool closed = false;
+    };
+
+    // Maximum distance between a curve and its flattened polyline.
+    static constexpr const f32 TOLERANCE = 0.25f;
+
+  public:
+    Path() = default;
+
+    Path& moveTo(const Vec2& point);
+    Path& lineTo(const Vec2& point);
+    Path& quadraticTo(const Vec2& control, const Vec2& point);
+    Path& cubicTo(const Vec2& control1, const Vec2& control2, const Vec2& point);
+
+    // Joins the current subpath back to its first point.
+    Path& close();
+
+    void clear();
+
+    inline bool isEmpty() const { return mContours.empty(); }
+    inline usize getPointCount() const { return mPointCount; }
+    inline const std::vector<Contour>& getContours() const { return mContours; }
+
+    // Tessellated on first use, then cached until the path or the stroke changes.
+    const Mesh& getStroke(const Stroke& stroke) const;
+
+    // Each subpath is filled as a simple polygon, self-intersections and holes
+    // are not handled.
+    const Mesh& getFill() const;
+
+  private:
+    Contour& current();
+    void changed();
+
+  private:
+    std::vector<Contour> mContours;
+    usize mPointCount = 0;
+    bool mOpen = false;
+
+    mutable Mesh   mStrokeMesh;
+    mutable Stroke mStrokeStyle;
+    mutable bool   mStrokeValid = false;
+
+    mutable Mesh mFillMesh;
+    mutable bool mFillValid = false;
+  };
+
+} // namespace Gui
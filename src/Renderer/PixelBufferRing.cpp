@@ -0,0 +1,85 @@
+#include "Core/OpenGL.hpp"
+#include "Renderer/PixelBufferRing.hpp"
+#include "Renderer/GLState.hpp"
+
+#include <cstring>
+
+namespace Gui {
+
+  PixelBufferRing::Handle PixelBufferRing::create(usize slotSize) {
+    GUI_ASSERT(slotSize != 0);
+
+    u32 id;
+    glGenBuffers(1, &id);
+    GLState::get().bindBuffer(GL_PIXEL_UNPACK_BUFFER, id);
+
+    u8* mapping = nullptr;
+    #ifdef GUI_PLATFORM_WEB
+      glBufferData(GL_PIXEL_UNPACK_BUFFER, slotSize, nullptr, GL_STREAM_DRAW);
+    #else
+      const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+      glBufferStorage(GL_PIXEL_UNPACK_BUFFER, slotSize * SLOT_COUNT, nullptr, flags);
+      mapping = (u8*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, slotSize * SLOT_COUNT, flags);
+      GUI_ASSERT_WITH_MESSAGE(mapping, "couldn't map pixel buffer");
+    #endif
+
+    GLState::get().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    Logger::trace("Pixel buffer ring #%u created: %u slots of %zu bytes", id, SLOT_COUNT, slotSize);
+    return makeRef<PixelBufferRing>(id, slotSize, mapping);
+  }
+
+  PixelBufferRing::~PixelBufferRing() {
+    for (auto fence : mFences) {
+      if (fence) {
+        glDeleteSync((GLsync)fence);
+      }
+    }
+
+    // Deleting a mapped buffer unmaps it.
+    Logger::trace("Pixel buffer ring #%u destroyed", mId);
+    GLState::get().deleteBuffer(mId);
+  }
+
+  usize PixelBufferRing::write(const void* pixels, usize size) {
+    GUI_ASSERT_WITH_MESSAGE(size <= mSlotSize, "pixels don't fit in a pixel buffer slot");
+
+    mSlot = (mSlot + 1) % SLOT_COUNT;
+    mStats.writes++;
+
+    GLState::get().bindBuffer(GL_PIXEL_UNPACK_BUFFER, mId);
+
+    #ifdef GUI_PLATFORM_WEB
+      // Orphan the old storage, the driver keeps it alive until the GPU is done with it.
+      glBufferData(GL_PIXEL_UNPACK_BUFFER, mSlotSize, nullptr, GL_STREAM_DRAW);
+      glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, size, pixels);
+      return 0;
+    #else
+      if (auto fence = (GLsync)mFences[mSlot]) {
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+          mStats.stalls++;
+          do {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+          } while (result == GL_TIMEOUT_EXPIRED);
+        }
+        glDeleteSync(fence);
+        mFences[mSlot] = nullptr;
+      }
+
+      const usize offset = mSlot * mSlotSize;
+      std::memcpy(mMapping + offset, pixels, size);
+      return offset;
+    #endif
+  }
+
+  void PixelBufferRing::submit() {
+    #ifndef GUI_PLATFORM_WEB
+      mFences[mSlot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    #endif
+
+    // Client memory uploads would be read as offsets into the ring otherwise.
+    GLState::get().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
+
+} // namespace Gui
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Core/Base.hpp"
+
+#include <array>
+
+namespace Gui {
+
+  // Ring of GL_PIXEL_UNPACK_BUFFER slots for streaming pixels to textures.
+  //
+  // The pixels of an upload are written into the next slot and the texture is
+  // updated from there, so the GPU copies them while the CPU already fills the
+  // next slot. Only when the ring wraps around faster than the GPU consumes it
+  // does write() wait.
+  //
+  // On desktop the buffer is persistently mapped. WebGL can't map buffers, so
+  // there the slot is orphaned and filled with glBufferSubData().
+  class PixelBufferRing : public RefCounted {
+  public:
+    using Handle = Ref<PixelBufferRing>;
+
+    static constexpr const u32 SLOT_COUNT = 3;
+
+    struct Stats {
+      u32 writes = 0;
+
+      // Writes that had to wait for the GPU to release their slot.
+      u32 stalls = 0;
+    };
+
+  public:
+    [[nodiscard]] static PixelBufferRing::Handle create(usize slotSize);
+    DISALLOW_MOVE_AND_COPY(PixelBufferRing);
+    ~PixelBufferRing();
+
+    // Copies the pixels into the next slot and binds the ring as the
+    // GL_PIXEL_UNPACK_BUFFER. Returns the offset of the slot, to be passed as
+    // the pixel pointer of the glTexSubImage2D() call that follows.
+    usize write(const void* pixels, usize size);
+
+    // Fences the slot of the last write() and unbinds the ring. Must be
+    // called after the upload that reads from it was issued.
+    void submit();
+
+    inline usize getSlotSize() const { return mSlotSize; }
+    inline const Stats& getStats() const { return mStats; }
+
+  public:
+    // DO NOT USE! Use PixelBufferRing::create()
+    //
+    // NOTE: It has to be public so it can be constructed by makeRef().
+    PixelBufferRing(u32 id, usize slotSize, u8* mapping)
+      : mId{id}, mSlotSize{slotSize}, mMapping{mapping}
+    {
+      mFences.fill(nullptr);
+    }
+
+  private:
+    u32 mId;
+    usize mSlotSize;
+
+    // Persistent mapping of all the slots, null on the web.
+    u8* mMapping;
+
+    // GLsync of the last upload from each slot.
+    std::array<void*, SLOT_COUNT> mFences;
+    u32 mSlot = 0;
+
+    Stats mStats;
+  };
+
+} // namespace Gui
@@ -0,0 +1,119 @@
+#include "Renderer/RenderCache.hpp"
+
+#include <algorithm>
+
+namespace Gui {
+
+  namespace {
+    u32 align(u32 value) {
+      return std::max(1u, (value + RenderCache::TARGET_ALIGNMENT - 1) / RenderCache::TARGET_ALIGNMENT) * RenderCache::TARGET_ALIGNMENT;
+    }
+
+    // Color and the depth/stencil render buffer.
+    usize estimateByteSize(u32 width, u32 height) {
+      return (usize)width * height * 8;
+    }
+  }
+
+  RenderCache& RenderCache::get() {
+    static RenderCache cache;
+    return cache;
+  }
+
+  bool RenderCache::acquire(u32 width, u32 height, FrameBuffer::Handle& target) {
+    width  = align(width);
+    height = align(height);
+
+    if (width > MAX_TARGET_SIZE || height > MAX_TARGET_SIZE) {
+      release(std::move(target));
+      target = nullptr;
+      mStats.rejected++;
+      return false;
+    }
+
+    if (target) {
+      if (target->getWidth() == width && target->getHeight() == height) {
+        return true;
+      }
+      release(std::move(target));
+      target = nullptr;
+    }
+
+    // The most recently released one is the most likely to still be in the GPU's caches.
+    for (usize i = mFree.size(); i-- > 0;) {
+      if (mFree[i].target->getWidth() == width && mFree[i].target->getHeight() == height) {
+        target = std::move(mFree[i].target);
+        mFree.erase(mFree.begin() + i);
+        mStats.reused++;
+        return true;
+      }
+    }
+
+    if (!makeRoom(estimateByteSize(width, height))) {
+      mStats.rejected++;
+      return false;
+    }
+
+    target = FrameBuffer::builder(width, height)
+      .clearColor(0.0f, 0.0f, 0.0f, 0.0f)
+      .attach(FrameBuffer::Attachment::Type::Texture, FrameBuffer::Attachment::Format::Rgba8)
+      .build();
+    mStats.created++;
+    mStats.targets++;
+    mStats.residentBytes += target->getByteSize();
+    return true;
+  }
+
+  void RenderCache::release(FrameBuffer::Handle target) {
+    if (!target) {
+      return;
+    }
+    mFree.push_back({std::move(target), mFrame});
+  }
+
+  bool RenderCache::makeRoom(usize bytes) {
+    if (bytes > mBudget) {
+      return false;
+    }
+
+    usize evict = 0;
+    while (evict < mFree.size() && mStats.residentBytes + bytes > mBudget) {
+      mStats.residentBytes -= mFree[evict].target->getByteSize();
+      mStats.targets--;
+      mStats.evictions++;
+      evict++;
+    }
+    mFree.erase(mFree.begin(), mFree.begin() + evict);
+    return mStats.residentBytes + bytes <= mBudget;
+  }
+
+  void RenderCache::trim() {
+    usize evict = 0;
+    while (evict < mFree.size() && mFrame - mFree[evict].releasedFrame > KEEP_FRAMES) {
+      mStats.residentBytes -= mFree[evict].target->getByteSize();
+      mStats.targets--;
+      mStats.evictions++;
+      evict++;
+    }
+    mFree.erase(mFree.begin(), mFree.begin() + evict);
+  }
+
+  void RenderCache::clear() {
+    for (auto& entry : mFree) {
+      mStats.residentBytes -= entry.target->getByteSize();
+      mStats.targets--;
+    }
+    mFree.clear();
+  }
+
+  void RenderCache::beginFrame() {
+    mFrame++;
+    trim();
+  }
+
+  void RenderCache::setBudget(usize bytes) {
+    mBudget = bytes;
+    makeRoom(0);
+  }
+
+} // namespace Gui
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Core/Base.hpp"
+#include "Renderer/FrameBuffer.hpp"
+
+#include <vector>
+
+namespace Gui {
+
+  // Render targets of widgets that are drawn from a texture, see
+  // Widget::setCacheMode().
+  //
+  // Sizes are rounded up to a multiple of TARGET_ALIGNMENT, so widgets of
+  // about the same size share targets. Released targets are kept for reuse
+  // for a while. A new target is only created while all of them fit the
+  // budget, otherwise the widget is drawn as usual.
+  class RenderCache {
+  public:
+    static constexpr const usize DEFAULT_BUDGET = 64 * 1024 * 1024;
+    static constexpr const u32 TARGET_ALIGNMENT = 64;
+    static constexpr const u32 MAX_TARGET_SIZE = 4096;
+
+    // The application caches the widgets in CacheMode::Auto with subtrees of
+    // at least this many widgets that haven't been marked dirty for this many frames.
+    static constexpr const u32 AUTO_CACHE_MIN_WIDGETS = 64;
+    static constexpr const u32 AUTO_CACHE_STABLE_FRAMES = 60;
+
+    // Released targets not reused for this many frames are destroyed.
+    static constexpr const u32 KEEP_FRAMES = 120;
+
+    struct Stats {
+      // Frames a cached widget was drawn from its texture, and rendered into it.
+      u32 hits   = 0;
+      u32 misses = 0;
+
+      // Over the budget, drawn without the cache.
+      u32 rejected = 0;
+
+      u32 created   = 0;
+      u32 reused    = 0;
+      u32 evictions = 0;
+      u32 targets   = 0;
+      usize residentBytes = 0;
+
+      inline f32 getHitRate() const {
+        return hits + misses == 0 ? 0.0f : (f32)hits / (f32)(hits + misses);
+      }
+    };
+
+  public:
+    static RenderCache& get();
+    DISALLOW_MOVE_AND_COPY(RenderCache);
+
+    // Makes `target` a target of at least width by height pixels, keeping it
+    // if it is already the right size. Returns false, with a null target, if
+    // it is larger than MAX_TARGET_SIZE or there is no room for it in the budget.
+    bool acquire(u32 width, u32 height, FrameBuffer::Handle& target);
+    void release(FrameBuffer::Handle target);
+
+    // Destroys the released targets that weren't reused recently.
+    void trim();
+    void clear();
+
+    // Counts frames, the widgets note in which frame they last changed.
+    inline u32 getFrame() const { return mFrame; }
+    void beginFrame();
+
+    void setBudget(usize bytes);
+    inline usize getBudget() const { return mBudget; }
+    inline const Stats& getStats() const { return mStats; }
+    inline void resetStats() { mStats.hits = mStats.misses = mStats.rejected = 0; }
+    inline void recordHit() { mStats.hits++; }
+    inline void recordMiss() { mStats.misses++; }
+
+  private:
+    RenderCache() = default;
+
+    // Destroys released targets, oldest first, until `bytes` more fit the budget.
+    bool makeRoom(usize bytes);
+
+  private:
+    struct Entry {
+      FrameBuffer::Handle target;
+      u32 releasedFrame;
+    };
+
+    // Oldest first.
+    std::vector<Entry> mFree;
+    usize mBudget = DEFAULT_BUDGET;
+    u32 mFrame = 1;
+    Stats mStats;
+  };
+
+} // namespace Gui
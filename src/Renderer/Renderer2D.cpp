@@ -1,5 +1,6 @@
 #include <array>
 #include <cctype>
+#include <cmath>
 
 #include "Core/OpenGL.hpp"
 #include <glm/gtc/matrix_transform.hpp>
@@ -7,16 +8,22 @@
 #include "Core/Base.hpp"
 
 #include "Renderer/Renderer2D.hpp"
+#include "Renderer/GLState.hpp"
 
 #include <LibGuiAssets/assets.hpp>
 
 namespace Gui {
 
+  namespace {
+    u32 packColor(const Vec4& color) {
+      auto channel = [](f32 value) { return (u32)(glm::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+      return channel(color.r) << 24 | channel(color.g) << 16 | channel(color.b) << 8 | channel(color.a);
+    }
+  }
+
   Renderer2D::Renderer2D(u32 width, u32 height)
     : mWidth{width}, mHeight{height}
   {
-    mWhiteTexture = Texture::color(0xFF, 0xFF, 0xFF).build();
-
     mQuadVertexArray = VertexArray::create();
     mQuadVertexBuffer = VertexBuffer::builder()
       .size(QUAD_VERTEX_BUFFER_BYTE_SIZE)
@@ -27,6 +34,11 @@ namespace Gui {
       .layout(BufferElement::Type::Uint)   // texIndex
       .layout(BufferElement::Type::Uint)   // aEffectMode
       .layout(BufferElement::Type::Float2) // aQuadSize
+      .layout(BufferElement::Type::Float4) // aRadii
+      .layout(BufferElement::Type::Float4) // aShape
+      .layout(BufferElement::Type::Float2) // aShadowOffset
+      .layout(BufferElement::Type::Uint)   // aBorderColor
+      .layout(BufferElement::Type::Uint)   // aShadowColor
       .build();
     mQuadVertexArray->addVertexBuffer(mQuadVertexBuffer);
 
@@ -57,8 +69,7 @@ namespace Gui {
     mQuadCurrentPtr = mQuadBasePtr;
     mQuadCount = 0;
 
-    mQuadTextures.reserve(MAX_TEXTURES);
-    mQuadTextures.push_back(mWhiteTexture);
+    mQuadTextureCount = 0;
 
     i32 samples[MAX_TEXTURES];
     for (u32 i = 0; i < Renderer2D::MAX_TEXTURES; ++i) {
@@ -67,6 +78,10 @@ namespace Gui {
     mQuadShader->bind();
     mQuadShader->setIntArray("uTextures", samples, MAX_TEXTURES);
 
+    mQuadArrayShader = Shader::load(assets.get("assets/shaders/QuadArray.glsl")).build();
+    mQuadArrayShader->bind();
+    mQuadArrayShader->setInt("uImages", 0);
+
     // Circles
     {
       mCircleVertexArray = VertexArray::create();
@@ -88,8 +103,62 @@ namespace Gui {
       mCircleShader = Shader::load(assets.get("assets/shaders/Circle.glsl")).build();
     }
 
+    // Paths
+    {
+      mPathVertexArray = VertexArray::create();
+      mPathVertexBuffer = VertexBuffer::builder()
+        .size(PATH_VERTEX_BUFFER_BYTE_SIZE)
+        .storage(Buffer::StorageType::Dynamic)
+        .layout(BufferElement::Type::Float2) // aPosition
+        .layout(BufferElement::Type::Float4) // aColor
+        .layout(BufferElement::Type::Float2) // aEdge
+        .build();
+      mPathVertexArray->addVertexBuffer(mPathVertexBuffer);
+      mPathVertexArray->unbind();
+      mPathBasePtr = new PathVertex[PATH_VERTICES_MAX];
+      mPathCurrentPtr = mPathBasePtr;
+      mPathVertexCount = 0;
+
+      mPathShader = Shader::load(assets.get("assets/shaders/Path.glsl")).build();
+    }
+
+    // Polylines
+    {
+      const Vec2 corners[] = {
+        Vec2{0.0f, -1.0f},
+        Vec2{1.0f, -1.0f},
+        Vec2{1.0f,  1.0f},
+        Vec2{0.0f,  1.0f},
+      };
+
+      mLineVertexArray = VertexArray::create();
+      auto cornerBuffer = VertexBuffer::builder()
+        .data(corners, sizeof(corners))
+        .layout(BufferElement::Type::Float2) // aCorner
+        .build();
+      mLineVertexArray->addVertexBuffer(cornerBuffer);
+
+      mLineInstanceBuffer = VertexBuffer::builder()
+        .size(LINE_INSTANCE_BUFFER_BYTE_SIZE)
+        .storage(Buffer::StorageType::Dynamic)
+        .layout(BufferElement::Type::Float2, 1) // aFrom
+        .layout(BufferElement::Type::Float2, 1) // aTo
+        .layout(BufferElement::Type::Float4, 1) // aColor
+        .layout(BufferElement::Type::Float,  1) // aWidth
+        .build();
+      mLineVertexArray->addVertexBuffer(mLineInstanceBuffer);
+      mLineVertexArray->setIndexBuffer(mQuadIndexBuffer); // Use quad index buffer
+      mLineVertexArray->unbind();
+      mLineBasePtr = new LineInstance[LINE_MAX];
+      mLineCurrentPtr = mLineBasePtr;
+      mLineCount = 0;
+
+      mLineShader = Shader::load(assets.get("assets/shaders/Line.glsl")).build();
+    }
+
+    // Linear so the text shader can blend across texel edges, see Effect::Type::Text.
     auto fontTexture = Texture::load(assets.get("assets/textures/PixelFont_7x9_112x54.png"))
-      .filtering(Texture::FilteringMode::Nearest)
+      .filtering(Texture::FilteringMode::Linear)
       .mipmap(Texture::MipmapMode::None)
       .build();
 
@@ -107,6 +176,8 @@ namespace Gui {
   Renderer2D::~Renderer2D() {
     delete[] mQuadBasePtr;
     delete[] mCircleBasePtr;
+    delete[] mPathBasePtr;
+    delete[] mLineBasePtr;
   }
 
   void Renderer2D::invalidate(u32 width, u32 height) {
@@ -118,6 +189,9 @@ namespace Gui {
 
   void Renderer2D::begin(const Camera& camera) {
     mProjectionViewMatrix = camera.getProjectionViewMatrix();
+    mTranslation = Vec2{0.0f};
+    mTranslationOnly = true;
+    mOpacity = 1.0f;
   }
 
   void Renderer2D::drawChar(char c, const Vec2& position, const Vec2& size, const Vec4& color, Effect effect) {
@@ -125,8 +199,12 @@ namespace Gui {
       c = (usize)('~' + 1);
     }
 
-    auto texture = mFontAtlas.get(u32(c - ' '));
-    drawQuad(position, size, texture, color, effect);
+    Vec2 from, to;
+    mFontAtlas.getTextureCoordinates(u32(c - ' '), from, to);
+    if (effect.getType() == Effect::Type::None) {
+      effect = Effect::Type::Text;
+    }
+    drawTexturedQuad(position, size, mFontAtlas.getTexture(), from, to, color, effect);
   }
 
   void Renderer2D::drawText(const StringView& text, const Vec2& position, const float _size, const Vec4& color, Effect effect) {
@@ -145,6 +223,48 @@ namespace Gui {
     }
   }
 
+  void Renderer2D::layoutText(const StringView& text, std::vector<Glyph>& out) const {
+    Vec2 cell{0.0f};
+    for (char c : text) {
+      if (c == '\n') {
+        cell = {0.0f, cell.y + 1.0f};
+        continue;
+      }
+      if (!std::isprint(c)) {
+        c = (usize)('~' + 1);
+      }
+
+      Glyph glyph = {cell, {}, {}};
+      mFontAtlas.getTextureCoordinates(u32(c - ' '), glyph.from, glyph.to);
+      out.push_back(glyph);
+      cell.x += 1.0f;
+    }
+  }
+
+  void Renderer2D::drawGlyphs(Slice<const Glyph> glyphs, const Vec2& position, const float _size, const Vec4& color, f32 columns) {
+    if (glyphs.size() == 0) {
+      return;
+    }
+    if (mQuadArray) {
+      flushQuad();
+      mQuadArray = nullptr;
+    }
+
+    const Vec2 size = {_size - _size/7.0f, _size};
+    const auto& texture = mFontAtlas.getTexture();
+    u32 index = quadTextureIndex(texture);
+    for (const auto& glyph : glyphs) {
+      if (glyph.cell.x + 1.0f > columns) {
+        continue;
+      }
+      if (mQuadCount >= RECT_MAX) {
+        flushQuad();
+        index = quadTextureIndex(texture);
+      }
+      pushQuad(position + glyph.cell * size, size, glyph.from, glyph.to, index, color, Effect::Type::Text);
+    }
+  }
+
   void Renderer2D::drawCenteredQuad(const Vec2& position, const Vec2& size, const Vec4& color, Effect effect) {
     drawQuad(position - size / 2.0f, size, color, effect);
   }
@@ -154,37 +274,82 @@ namespace Gui {
   }
 
   void Renderer2D::drawQuad(const Vec2& position, const Vec2& size, const Vec4& color, Effect effect) {
-    Renderer2D::drawQuad(position, size, mWhiteTexture, color, effect);
+    Vec2 from = position, extent = size;
+    snapToPixels(from, extent);
+    drawTexturedQuad(from, extent, nullptr, Vec2{0.0f, 0.0f}, Vec2{1.0f, 1.0f}, color, effect);
   }
 
   void Renderer2D::drawQuad(const Vec2& position, const Vec2& size, const SubTexture& texture, const Vec4& color, Effect effect) {
-    Mat4 transform = Mat4(1.0f);
-    transform = glm::translate(transform, glm::vec3(position, 0.0f));
+    Vec2 from = position, extent = size;
+    snapToPixels(from, extent);
+    drawTexturedQuad(from, extent, texture.getTexture(), texture.getFrom(), texture.getTo(), color, effect);
+  }
 
-    transform = glm::scale(transform, glm::vec3(size, 1.0f));
+  void Renderer2D::snapToPixels(Vec2& position, Vec2& size) const {
+    if (!mSnapToPixels || !mTranslationOnly) {
+      return;
+    }
+    const Vec2 end = glm::round(position + size + mTranslation) - mTranslation;
+    position = glm::round(position + mTranslation) - mTranslation;
+    size = end - position;
+  }
+
+  void Renderer2D::drawImage(const Vec2& position, const Vec2& size, const TextureArray::Image& image, const Vec4& color) {
+    if (mQuadArray != image.getArray()) {
+      flushQuad();
+      mQuadArray = image.getArray();
+    }
 
     if (mQuadCount >= RECT_MAX) {
       flushQuad();
     }
 
-    u32 index = 0;
-    for (; index < mQuadTextures.size(); ++index) {
-      if (mQuadTextures[index] == texture.getTexture()) {
-        break;
-      }
+    pushQuad(position, size, image.getFrom(), image.getTo(), image.getLayer(), color, Effect::Type::None);
+  }
+
+  void Renderer2D::drawTexturedQuad(const Vec2& position, const Vec2& size, const Texture::Handle& texture, const Vec2& from, const Vec2& to, const Vec4& color, Effect effect) {
+    if (mQuadArray) {
+      flushQuad();
+      mQuadArray = nullptr;
+    }
+
+    if (mQuadCount >= RECT_MAX) {
+      flushQuad();
     }
 
-    if (index == mQuadTextures.size()) {
-      if (mQuadTextures.size() >= MAX_TEXTURES) {
-        flush();
+    if (!texture) {
+      pushQuad(position, size, from, to, SOLID_TEXTURE_INDEX, color, effect);
+      return;
+    }
+
+    pushQuad(position, size, from, to, quadTextureIndex(texture), color, effect);
+  }
+
+  u32 Renderer2D::quadTextureIndex(const Texture::Handle& texture) {
+    for (u32 index = 0; index < mQuadTextureCount; ++index) {
+      if (mQuadTextures[index] == texture) {
+        return index;
       }
+    }
 
-      index = (u32)mQuadTextures.size();
-      mQuadTextures.push_back(texture.getTexture());
+    if (mQuadTextureCount >= MAX_TEXTURES) {
+      flush();
     }
+    mQuadTextures[mQuadTextureCount] = texture;
+    return mQuadTextureCount++;
+  }
+
+  void Renderer2D::pushQuad(const Vec2& position, const Vec2& size, const Vec2& from, const Vec2& to, u32 index, const Vec4& _color, Effect effect) {
+    flushPath();
+    flushLine();
+
+    Vec4 color = _color;
+    color.a *= mOpacity;
+
+    Mat4 transform = Mat4(1.0f);
+    transform = glm::translate(transform, glm::vec3(position, 0.0f));
 
-    const auto from = texture.getFrom();
-    const auto to = texture.getTo();
+    transform = glm::scale(transform, glm::vec3(size, 1.0f));
 
     *(mQuadCurrentPtr++) = { Vec2(mProjectionViewMatrix * transform * QUAD_POSITIONS[0]), color, {to.x,     to.y}, index, effect.toIndex(), size}; // top-right
     *(mQuadCurrentPtr++) = { Vec2(mProjectionViewMatrix * transform * QUAD_POSITIONS[1]), color, {to.x,   from.y}, index, effect.toIndex(), size}; // bottom-right
@@ -194,24 +359,129 @@ namespace Gui {
     mQuadCount++;
   }
 
+  void Renderer2D::drawRect(const Vec2& position, const Vec2& size, const RectStyle& style) {
+    if (mQuadArray) {
+      flushQuad();
+      mQuadArray = nullptr;
+    }
+
+    if (mQuadCount >= RECT_MAX) {
+      flushQuad();
+    }
+
+    f32 borderInner = 0.0f;
+    f32 borderOuter = 0.0f;
+    switch (style.borderAlign) {
+      case RectStyle::BorderAlign::Inside:  borderInner = style.borderWidth;        break;
+      case RectStyle::BorderAlign::Center:  borderInner = style.borderWidth / 2.0f;
+                                            borderOuter = style.borderWidth / 2.0f; break;
+      case RectStyle::BorderAlign::Outside: borderOuter = style.borderWidth;        break;
+    }
+
+    // Corners can't be rounder than half the smaller side.
+    const f32 maxRadius = glm::min(size.x, size.y) / 2.0f;
+    const Vec4 radii = glm::clamp(style.radii, 0.0f, maxRadius);
+
+    // The quad covers the outer border and the shadow, plus a pixel for the anti-aliasing.
+    const bool shadow = style.shadowColor.a > 0.0f;
+    f32 margin = borderOuter;
+    if (shadow) {
+      margin = glm::max(margin, glm::max(glm::abs(style.shadowOffset.x), glm::abs(style.shadowOffset.y)) + style.shadowBlur);
+    }
+    margin += 1.0f;
+
+    // Texture coordinates are the position relative to the center of the rectangle.
+    const Vec2 extent = size / 2.0f + margin;
+    pushQuad(position - margin, size + margin * 2.0f, Vec2{-extent.x, extent.y}, Vec2{extent.x, -extent.y}, SOLID_TEXTURE_INDEX, style.color, Effect::Type::Shape);
+
+    const Vec4 shape        = {borderInner, borderOuter, style.shadowBlur, 0.0f};
+    const u32  borderColor  = packColor(style.borderColor * Vec4{1.0f, 1.0f, 1.0f, mOpacity});
+    const u32  shadowColor  = shadow ? packColor(style.shadowColor * Vec4{1.0f, 1.0f, 1.0f, mOpacity}) : 0;
+    for (QuadVertex* vertex = mQuadCurrentPtr - QUAD_VERTICES_COUNT; vertex != mQuadCurrentPtr; ++vertex) {
+      vertex->quadSize     = size;
+      vertex->radii        = radii;
+      vertex->shape        = shape;
+      vertex->shadowOffset = style.shadowOffset;
+      vertex->borderColor  = borderColor;
+      vertex->shadowColor  = shadowColor;
+    }
+  }
+
+  void Renderer2D::drawPath(const Path& path, const Path::Stroke& stroke, const Vec4& color, const Vec2& offset) {
+    if (path.getPointCount() <= INSTANCED_POLYLINE_POINTS) {
+      pushMesh(path.getStroke(stroke), color, offset);
+      return;
+    }
+
+    for (const auto& contour : path.getContours()) {
+      const auto& points = contour.points;
+      drawPolyline({points.data(), points.size()}, stroke.width, color, offset);
+      if (contour.closed && points.size() > 2) {
+        const Vec2 closing[] = {points.back(), points.front()};
+        drawPolyline(closing, stroke.width, color, offset);
+      }
+    }
+  }
+
+  void Renderer2D::fillPath(const Path& path, const Vec4& color, const Vec2& offset) {
+    pushMesh(path.getFill(), color, offset);
+  }
+
+  void Renderer2D::pushMesh(const Path::Mesh& mesh, const Vec4& color, const Vec2& offset) {
+    flushQuad();
+    flushLine();
+
+    const Vec4 faded = {color.r, color.g, color.b, color.a * mOpacity};
+
+    for (usize i = 0; i < mesh.size(); ++i) {
+      // Whole triangles only.
+      if (i % 3 == 0 && mPathVertexCount + 3 > PATH_VERTICES_MAX) {
+        flushPath();
+      }
+
+      const auto& vertex = mesh[i];
+      *(mPathCurrentPtr++) = { Vec2(mProjectionViewMatrix * Vec4(vertex.position + offset, 0.0f, 1.0f)), faded, vertex.edge };
+      mPathVertexCount++;
+    }
+  }
+
+  void Renderer2D::drawPolyline(Slice<const Vec2> points, f32 width, const Vec4& color, const Vec2& offset) {
+    flushQuad();
+    flushPath();
+
+    const Vec4 faded = {color.r, color.g, color.b, color.a * mOpacity};
+
+    for (usize i = 1; i < points.size(); ++i) {
+      if (mLineCount >= LINE_MAX) {
+        flushLine();
+      }
+
+      *(mLineCurrentPtr++) = { points.data()[i - 1] + offset, points.data()[i] + offset, faded, width };
+      mLineCount++;
+    }
+  }
+
   void Renderer2D::clearScreen(const Vec4& color) {
-    clearScreen(mWhiteTexture, color);
+    drawQuad(Vec2{0, 0}, Vec2{mWidth, mHeight}, color);
   }
 
   void Renderer2D::clearScreen(const Texture::Handle& texture, const Vec4& color) {
-    drawQuad(Vec2{0, 0}, Vec2{mWidth, mHeight}, texture, color);
+    drawTexturedQuad(Vec2{0, 0}, Vec2{mWidth, mHeight}, texture, Vec2{0.0f, 0.0f}, Vec2{1.0f, 1.0f}, color, Effect::Type::None);
   }
   void Renderer2D::flushQuad() {
     if (mQuadCount) {
-      mWhiteTexture->bind();
+      if (mQuadArray) {
+        mQuadArray->bind(0);
+        mQuadArrayShader->bind();
+      } else {
+        for (u32 i = 0; i < mQuadTextureCount; ++i) {
+          mQuadTextures[i]->bind(i);
+        }
 
-      for (u32 i = 0; i < mQuadTextures.size(); ++i) {
-        mQuadTextures[i]->bind(i);
+        mQuadShader->bind();
+        mQuadShader->setFloat("uTime", (f32)glfwGetTime());
       }
 
-      mQuadShader->bind();
-      mQuadShader->setFloat("uTime", (f32)glfwGetTime());
-
       mQuadVertexArray->bind();
       mQuadVertexBuffer->set({mQuadBasePtr,  mQuadCount * QUAD_VERTICES_COUNT});
       mQuadVertexArray->drawIndices(mQuadCount * QUAD_INDICES_COUNT);
@@ -219,8 +489,10 @@ namespace Gui {
       mQuadCurrentPtr = mQuadBasePtr;
       mQuadCount = 0;
 
-      mQuadTextures.clear();
-      mQuadTextures.push_back(mWhiteTexture);
+      for (u32 i = 0; i < mQuadTextureCount; ++i) {
+        mQuadTextures[i] = nullptr;
+      }
+      mQuadTextureCount = 0;
     }
   }
   void Renderer2D::drawCenteredCircle(const Vec2& position, float radius, const Vec4& color, float thickness, float fade) {
@@ -249,7 +521,7 @@ namespace Gui {
 		for (size_t i = 0; i < CIRCLE_VERTICES_COUNT; i++) {
 			mCircleCurrentPtr->worldPosition = Vec2(mProjectionViewMatrix * transform * QUAD_POSITIONS[i]);
 			mCircleCurrentPtr->localPosition = localPositions[i];
-			mCircleCurrentPtr->color         = color;
+			mCircleCurrentPtr->color         = {color.r, color.g, color.b, color.a * mOpacity};
 			mCircleCurrentPtr->thickness     = thickness;
 			mCircleCurrentPtr->fade          = fade;
 			mCircleCurrentPtr++;
@@ -258,8 +530,6 @@ namespace Gui {
 	}
   void Renderer2D::flushCircle() {
     if (mCircleCount) {
-      // mWhiteTexture->bind();
-
       for (u32 i = 0; i < mCircleTextures.size(); ++i) {
         mCircleTextures[i]->bind(i);
       }
@@ -273,16 +543,262 @@ namespace Gui {
       mCircleCurrentPtr = mCircleBasePtr;
       mCircleCount = 0;
 
-      // mCircleTextures.clear();
-      // mCircleTextures.push_back(mWhiteTexture);
+    }
+  }
+  void Renderer2D::flushPath() {
+    if (mPathVertexCount) {
+      mPathShader->bind();
+
+      mPathVertexArray->bind();
+      mPathVertexBuffer->set({mPathBasePtr, mPathVertexCount});
+      mPathVertexArray->drawArrays(mPathVertexCount);
+
+      mPathCurrentPtr = mPathBasePtr;
+      mPathVertexCount = 0;
+    }
+  }
+  void Renderer2D::flushLine() {
+    if (mLineCount) {
+      mLineShader->bind();
+      mLineShader->setMat4("uProjectionView", mProjectionViewMatrix);
+
+      mLineVertexArray->bind();
+      mLineInstanceBuffer->set({mLineBasePtr, mLineCount});
+      mLineVertexArray->drawIndicesInstanced(QUAD_INDICES_COUNT, mLineCount);
+
+      mLineCurrentPtr = mLineBasePtr;
+      mLineCount = 0;
     }
   }
   void Renderer2D::flush() {
     flushQuad();
     flushCircle();
+    flushPath();
+    flushLine();
   }
   void Renderer2D::end() {
     flush();
+
+    GUI_DEBUG_ASSERT(mClips.empty());
+    if (!mClips.empty()) {
+      mClips.clear();
+      applyClip();
+    }
+
+    GUI_DEBUG_ASSERT(mTransforms.empty());
+    if (!mTransforms.empty()) {
+      mProjectionViewMatrix = mTransforms.front().projectionView;
+      mTransforms.clear();
+    }
+
+    GUI_DEBUG_ASSERT(mOpacities.empty());
+    mOpacities.clear();
+
+    GUI_DEBUG_ASSERT(mTargets.empty());
+    while (!mTargets.empty()) {
+      endTarget();
+    }
+  }
+
+  void Renderer2D::beginTarget(const FrameBuffer::Handle& target, const Vec2& position) {
+    flush();
+
+    mTargets.push_back({
+      target, mWidth, mHeight, mProjectionViewMatrix,
+      std::move(mClips), std::move(mTransforms), mTranslation, mTranslationOnly,
+      std::move(mOpacities), mOpacity,
+    });
+
+    mWidth  = target->getWidth();
+    mHeight = target->getHeight();
+    mProjectionViewMatrix = glm::ortho(position.x, position.x + mWidth, position.y + mHeight, position.y);
+    mClips.clear();
+    mTransforms.clear();
+    mOpacities.clear();
+    mTranslation = Vec2{0.0f};
+    mTranslationOnly = true;
+    mOpacity = 1.0f;
+
+    // Without the clip stack this turns off the scissor test, which would
+    // otherwise limit the clear on bind to the caller's clip.
+    applyClip();
+    target->bind();
+    GLState::get().viewport(0, 0, (i32)mWidth, (i32)mHeight);
+
+    // Keeps the colors premultiplied by their alpha, so the target blends
+    // like the shapes drawn into it would have.
+    GLState::get().blending(true);
+    GLState::get().blendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    mQuadShader->bind();
+    mQuadShader->setVec2("uResolution", Vec2{mWidth, mHeight});
+  }
+
+  void Renderer2D::endTarget() {
+    GUI_DEBUG_ASSERT(!mTargets.empty());
+    GUI_DEBUG_ASSERT(mClips.empty() && mTransforms.empty() && mOpacities.empty());
+
+    flush();
+
+    auto state = std::move(mTargets.back());
+    mTargets.pop_back();
+    mWidth  = state.width;
+    mHeight = state.height;
+    mProjectionViewMatrix = state.projectionView;
+    mClips = std::move(state.clips);
+    mTransforms = std::move(state.transforms);
+    mTranslation = state.translation;
+    mTranslationOnly = state.translationOnly;
+    mOpacities = std::move(state.opacities);
+    mOpacity = state.opacity;
+
+    if (mTargets.empty()) {
+      GLState::get().bindFramebuffer(GL_FRAMEBUFFER, 0);
+      GLState::get().blending(mBlending);
+      GLState::get().blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+      GLState::get().bindFramebuffer(GL_FRAMEBUFFER, mTargets.back().target->getId());
+    }
+    GLState::get().viewport(0, 0, (i32)mWidth, (i32)mHeight);
+    applyClip();
+    mQuadShader->bind();
+    mQuadShader->setVec2("uResolution", Vec2{mWidth, mHeight});
+  }
+
+  void Renderer2D::drawTarget(const FrameBuffer::Handle& target, const Vec2& position, const Vec2& size) {
+    flushQuad();
+
+    const Vec2 extent = Vec2{target->getWidth(), target->getHeight()};
+    const Vec2 from = {0.0f, 1.0f - size.y / extent.y};
+    const Vec2 to   = {size.x / extent.x, 1.0f};
+
+    // The texture is premultiplied, and so is the color it is tinted with.
+    const bool blending = mBlending || !mTargets.empty();
+    GLState::get().blending(true);
+    GLState::get().blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    Vec2 quadPosition = position, quadSize = size;
+    snapToPixels(quadPosition, quadSize);
+    drawTexturedQuad(quadPosition, quadSize, target->getColorAttachment(), from, to, Vec4{mOpacity, mOpacity, mOpacity, 1.0f}, Effect::Type::None);
+    flushQuad();
+
+    GLState::get().blending(blending);
+    if (mTargets.empty()) {
+      GLState::get().blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+      GLState::get().blendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+  }
+
+  Renderer2D::ClipRect Renderer2D::toPixels(const Vec2& position, const Vec2& size) const {
+    Vec2 min = Vec2(mProjectionViewMatrix * Vec4(position, 0.0f, 1.0f));
+    Vec2 max = min;
+    if (mTranslationOnly) {
+      const Vec2 other = Vec2(mProjectionViewMatrix * Vec4(position + size, 0.0f, 1.0f));
+      min = glm::min(min, other);
+      max = glm::max(max, other);
+    } else {
+      for (const Vec2 corner : {Vec2{size.x, 0.0f}, Vec2{0.0f, size.y}, size}) {
+        const Vec2 other = Vec2(mProjectionViewMatrix * Vec4(position + corner, 0.0f, 1.0f));
+        min = glm::min(min, other);
+        max = glm::max(max, other);
+      }
+    }
+    return {
+      (min + 1.0f) * 0.5f * Vec2{mWidth, mHeight},
+      (max + 1.0f) * 0.5f * Vec2{mWidth, mHeight},
+    };
+  }
+
+  void Renderer2D::pushClip(const Vec2& position, const Vec2& size) {
+    flush();
+
+    ClipRect clip = toPixels(position, size);
+    if (!mClips.empty()) {
+      clip.min = glm::max(clip.min, mClips.back().min);
+      clip.max = glm::min(clip.max, mClips.back().max);
+    }
+    clip.max = glm::max(clip.min, clip.max);
+    mClips.push_back(clip);
+    applyClip();
+  }
+
+  void Renderer2D::popClip() {
+    GUI_DEBUG_ASSERT(!mClips.empty());
+
+    flush();
+    mClips.pop_back();
+    applyClip();
+  }
+
+  void Renderer2D::applyClip() {
+    if (mClips.empty()) {
+      GLState::get().scissorTest(false);
+      return;
+    }
+
+    const auto& clip = mClips.back();
+    const i32 x = (i32)std::floor(clip.min.x);
+    const i32 y = (i32)std::floor(clip.min.y);
+    GLState::get().scissor(x, y, (i32)std::ceil(clip.max.x) - x, (i32)std::ceil(clip.max.y) - y);
+    GLState::get().scissorTest(true);
+  }
+
+  void Renderer2D::pushTransform(const Mat4& transform) {
+    // The line shader reads the matrix from a uniform.
+    flushLine();
+
+    mTransforms.push_back({mProjectionViewMatrix, mTranslation, mTranslationOnly});
+    mProjectionViewMatrix = mProjectionViewMatrix * transform;
+
+    const bool translation = transform[0] == Vec4{1.0f, 0.0f, 0.0f, 0.0f}
+                          && transform[1] == Vec4{0.0f, 1.0f, 0.0f, 0.0f}
+                          && transform[2] == Vec4{0.0f, 0.0f, 1.0f, 0.0f};
+    mTranslationOnly = mTranslationOnly && translation;
+    mTranslation += Vec2(transform[3]);
+  }
+
+  void Renderer2D::pushTranslation(const Vec2& offset) {
+    pushTransform(glm::translate(Mat4(1.0f), Vec3(offset, 0.0f)));
+  }
+
+  void Renderer2D::popTransform() {
+    GUI_DEBUG_ASSERT(!mTransforms.empty());
+
+    flushLine();
+    const auto& state = mTransforms.back();
+    mProjectionViewMatrix = state.projectionView;
+    mTranslation = state.translation;
+    mTranslationOnly = state.translationOnly;
+    mTransforms.pop_back();
+  }
+
+  void Renderer2D::pushOpacity(f32 opacity) {
+    mOpacities.push_back(mOpacity);
+    mOpacity *= opacity;
+  }
+
+  void Renderer2D::popOpacity() {
+    GUI_DEBUG_ASSERT(!mOpacities.empty());
+
+    mOpacity = mOpacities.back();
+    mOpacities.pop_back();
+  }
+
+  bool Renderer2D::isVisible(const Vec2& position, const Vec2& size) const {
+    ClipRect bounds = {Vec2{0.0f}, Vec2{mWidth, mHeight}};
+    if (!mClips.empty()) {
+      bounds = mClips.back();
+    }
+
+    const ClipRect rect = toPixels(position, size);
+    return rect.min.x < bounds.max.x
+        && rect.min.y < bounds.max.y
+        && rect.max.x > bounds.min.x
+        && rect.max.y > bounds.min.y;
+  }
+
+  void Renderer2D::setAntiAliasing(AntiAliasing antiAliasing) {
+    mSnapToPixels = antiAliasing == AntiAliasing::None;
   }
 
   void Renderer2D::blending(bool yes) {
@@ -293,11 +809,9 @@ namespace Gui {
     flush();
 
     mBlending = yes;
+    GLState::get().blending(mBlending);
     if (mBlending) {
-      glEnable(GL_BLEND);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    } else {
-      glDisable(GL_BLEND);
+      GLState::get().blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     }
   }
 
@@ -2,10 +2,14 @@
 
 #include "Renderer/Shader.hpp"
 #include "Renderer/Texture.hpp"
+#include "Renderer/TextureArray.hpp"
 #include "Renderer/VertexArray.hpp"
 #include "Renderer/CameraController.hpp"
+#include "Renderer/Path.hpp"
+#include "Renderer/FrameBuffer.hpp"
 
 #include <array>
+#include <vector>
 
 namespace Gui {
 
@@ -16,6 +20,10 @@ namespace Gui {
       Striped = 1,
       Static  = 2,
       Rounded = 3,
+
+      // Set by Renderer2D::drawRect() and drawChar().
+      Shape   = 4,
+      Text    = 5,
     };
 
   public:
@@ -27,18 +35,72 @@ namespace Gui {
       return u32(mType);
     }
 
+    Type getType() const {
+      return mType;
+    }
+
   private:
     Type mType;
   };
 
+  // Multisampling of the window framebuffer. Without it the shaders
+  // anti-alias: shapes and circles from their distance fields, text by
+  // filtering across texel edges, and quads are snapped to whole pixels.
+  enum class AntiAliasing : u8 {
+    None  = 0,
+    Msaa2 = 2,
+    Msaa4 = 4,
+    Msaa8 = 8,
+  };
+
+  // Rounded rectangle with an optional border and drop shadow. It is drawn as a
+  // single quad that computes its coverage from a signed distance field, so
+  // edges are anti-aliased without MSAA and nothing is drawn twice.
+  struct RectStyle {
+    enum class BorderAlign : u8 {
+      Inside,
+      Center,
+      Outside,
+    };
+
+    Vec4 color = Color::WHITE;
+
+    // Top-left, top-right, bottom-right, bottom-left.
+    Vec4 radii = Vec4{0.0f};
+
+    f32         borderWidth = 0.0f;
+    Vec4        borderColor = Color::BLACK;
+    BorderAlign borderAlign = BorderAlign::Inside;
+
+    Vec4 shadowColor  = Color::TRANSPARENT;
+    Vec2 shadowOffset = Vec2{0.0f};
+    f32  shadowBlur   = 0.0f;
+  };
+
+  // A character of text laid out ahead of time, see Renderer2D::layoutText().
+  struct Glyph {
+    // In character cells from the start of the text, x along the line and y the line.
+    Vec2 cell;
+
+    // In the font atlas.
+    Vec2 from;
+    Vec2 to;
+  };
+
   class Renderer2D {
     friend class Application;
+  public:
+    // Strokes of paths with more points are drawn with drawPolyline() instead
+    // of being tessellated, ignoring the joins and caps.
+    static constexpr const usize INSTANCED_POLYLINE_POINTS = 4096;
+
   public:
     Renderer2D(u32 width, u32 height);
     DISALLOW_MOVE_AND_COPY(Renderer2D);
     ~Renderer2D();
 
     void blending(bool yes = true);
+    void setAntiAliasing(AntiAliasing antiAliasing);
 
     void begin(const Camera& camera);
     void end();
@@ -57,12 +119,93 @@ namespace Gui {
     void drawChar(char c, const Vec2& position,  const Vec2& size, const Vec4& color = Color::WHITE, Effect effect = Effect::Type::None);
     void drawText(const StringView& text, const Vec2& position, const float size, const Vec4& color = Color::WHITE, Effect effect = Effect::Type::None);
 
+    // Appends the glyphs of `text` to `out`, so text drawn every frame is only
+    // looked up in the font atlas once. Independent of the size it is drawn at.
+    void layoutText(const StringView& text, std::vector<Glyph>& out) const;
+
+    // Same as drawText() of the laid out text, the glyphs past `columns`
+    // character cells on their line are skipped.
+    void drawGlyphs(Slice<const Glyph> glyphs, const Vec2& position, const float size, const Vec4& color = Color::WHITE, f32 columns = INFINITY);
+
+    // Batched with the quads.
+    void drawRect(const Vec2& position, const Vec2& size, const RectStyle& style);
+
+    // Images of the same TextureArray share a batch, regardless of how many there are.
+    void drawImage(const Vec2& position, const Vec2& size, const TextureArray::Image& image, const Vec4& color = Color::WHITE);
+
+    // The path caches its triangles, see Path. Paths, polylines and quads are
+    // separate batches, switching between them flushes.
+    void drawPath(const Path& path, const Path::Stroke& stroke, const Vec4& color, const Vec2& offset = Vec2{0.0f});
+    void fillPath(const Path& path, const Vec4& color, const Vec2& offset = Vec2{0.0f});
+
+    // Each segment is one instance expanded into a quad by the vertex shader, so
+    // nothing is tessellated. Segments have square ends and overlap at the
+    // points, which suits long data series rather than thick outlines.
+    void drawPolyline(Slice<const Vec2> points, f32 width, const Vec4& color, const Vec2& offset = Vec2{0.0f});
+
+    // Nested clip rectangles, each one intersected with the ones it is pushed
+    // on. Changing the clip flushes every batch.
+    void pushClip(const Vec2& position, const Vec2& size);
+    void popClip();
+
+    // Transforms everything drawn until the matching pop, on top of the
+    // transforms it is pushed on. Quads, circles and paths are transformed as
+    // they are batched, so this doesn't flush them and cached path meshes are
+    // drawn as they are. Quads are only snapped to pixels while the transform
+    // is a translation.
+    void pushTransform(const Mat4& transform);
+    void pushTranslation(const Vec2& offset);
+    void popTransform();
+
+    // Multiplies the alpha of everything drawn until the matching pop. It is
+    // applied to each shape, so overlapping shapes show through each other.
+    void pushOpacity(f32 opacity);
+    void popOpacity();
+    inline f32 getOpacity() const { return mOpacity; }
+
+    // Draws into `target` until the matching endTarget(), with `position` at
+    // its top left corner, e.g. to cache a widget. The clips, transforms and
+    // opacity are those of a new frame until then. Targets hold premultiplied
+    // colors, draw them with drawTarget().
+    void beginTarget(const FrameBuffer::Handle& target, const Vec2& position);
+    void endTarget();
+
+    // Draws the top left `size` pixels of a target drawn with beginTarget().
+    void drawTarget(const FrameBuffer::Handle& target, const Vec2& position, const Vec2& size);
+
+    // Whether any of the rectangle is inside the current clip and the screen.
+    // Rotated rectangles and clips are tested by their bounding boxes.
+    bool isVisible(const Vec2& position, const Vec2& size) const;
+
     void flushCircle();
     void flushQuad();
+    void flushPath();
+    void flushLine();
     void flush();
 
     void invalidate(u32 width, u32 height);
 
+  private:
+    // Rounds the edges of axis aligned quads when the shaders anti-alias.
+    void snapToPixels(Vec2& position, Vec2& size) const;
+
+    // Slot of the texture in the quad batch, flushing when they are all taken.
+    u32 quadTextureIndex(const Texture::Handle& texture);
+
+    // A null texture draws a solid quad.
+    void drawTexturedQuad(const Vec2& position, const Vec2& size, const Texture::Handle& texture, const Vec2& from, const Vec2& to, const Vec4& color, Effect effect);
+    void pushQuad(const Vec2& position, const Vec2& size, const Vec2& from, const Vec2& to, u32 index, const Vec4& color, Effect effect);
+    void pushMesh(const Path::Mesh& mesh, const Vec4& color, const Vec2& offset);
+    void applyClip();
+
+    struct ClipRect {
+      Vec2 min;
+      Vec2 max;
+    };
+
+    // To framebuffer pixels, whose origin is the bottom left.
+    ClipRect toPixels(const Vec2& position, const Vec2& size) const;
+
   private:
     struct QuadVertex {
       Vec2 position;
@@ -71,6 +214,13 @@ namespace Gui {
       u32  texIndex;
       u32  mode;
       Vec2 quadSize;
+
+      // Only used by shapes.
+      Vec4 radii{0.0f};
+      Vec4 shape{0.0f};
+      Vec2 shadowOffset{0.0f};
+      u32  borderColor = 0;
+      u32  shadowColor = 0;
     };
 
     struct CircleVertex {
@@ -81,6 +231,19 @@ namespace Gui {
 		  float fade;
     };
 
+    struct PathVertex {
+      Vec2 position;
+      Vec4 color;
+      Vec2 edge;
+    };
+
+    struct LineInstance {
+      Vec2 from;
+      Vec2 to;
+      Vec4 color;
+      f32  width;
+    };
+
   private:
     static constexpr const std::array<Vec4, 4> QUAD_POSITIONS = {
       Vec4{ 1.0f,  0.0f, 0.0f, 1.0f }, // top    right
@@ -101,26 +264,38 @@ namespace Gui {
     static constexpr const u32 CIRCLE_VERTEX_BUFFER_BYTE_SIZE = CIRCLE_MAX * CIRCLE_VERTICES_COUNT * sizeof(CircleVertex);
     static constexpr const u32 CIRCLE_INDEX_BUFFER_COUNT      = CIRCLE_MAX * CIRCLE_INDICES_COUNT;
 
+    static constexpr const u32 PATH_VERTICES_MAX = 3 * 16384;
+    static constexpr const u32 PATH_VERTEX_BUFFER_BYTE_SIZE = PATH_VERTICES_MAX * sizeof(PathVertex);
+
+    static constexpr const u32 LINE_MAX = 16384;
+    static constexpr const u32 LINE_INSTANCE_BUFFER_BYTE_SIZE = LINE_MAX * sizeof(LineInstance);
+
     static constexpr const u32 MAX_TEXTURES = 16;
 
+    // Texture index of quads without a texture, the shader doesn't sample for them.
+    static constexpr const u32 SOLID_TEXTURE_INDEX = 0xFF;
+
   private:
     u32 mWidth;
     u32 mHeight;
 
     bool mBlending = false;
+    bool mSnapToPixels = true;
 
     // Camera
     Mat4 mProjectionViewMatrix;
 
-    // Cached default white texture
-    Texture::Handle mWhiteTexture;
-
     // Quad batching
     VertexArray::Handle  mQuadVertexArray;
     VertexBuffer::Handle mQuadVertexBuffer;
     IndexBuffer::Handle  mQuadIndexBuffer;
     Shader::Handle       mQuadShader;
-    std::vector<Texture::Handle> mQuadTextures;
+    std::array<Texture::Handle, MAX_TEXTURES> mQuadTextures;
+    u32 mQuadTextureCount = 0;
+
+    // When set, the quad batch samples this array and the texture index is the layer.
+    TextureArray::Handle mQuadArray;
+    Shader::Handle       mQuadArrayShader;
     QuadVertex* mQuadBasePtr = nullptr;
     QuadVertex* mQuadCurrentPtr = nullptr;
     u32 mQuadCount = 0;
@@ -133,6 +308,53 @@ namespace Gui {
     CircleVertex* mCircleCurrentPtr = nullptr;
     u32 mCircleCount = 0;
 
+    VertexArray::Handle  mPathVertexArray;
+    VertexBuffer::Handle mPathVertexBuffer;
+    Shader::Handle       mPathShader;
+    PathVertex* mPathBasePtr = nullptr;
+    PathVertex* mPathCurrentPtr = nullptr;
+    u32 mPathVertexCount = 0;
+
+    // One quad of the quad index buffer, instanced per segment.
+    VertexArray::Handle  mLineVertexArray;
+    VertexBuffer::Handle mLineInstanceBuffer;
+    Shader::Handle       mLineShader;
+    LineInstance* mLineBasePtr = nullptr;
+    LineInstance* mLineCurrentPtr = nullptr;
+    u32 mLineCount = 0;
+
+    // In framebuffer pixels.
+    std::vector<ClipRect> mClips;
+
+    struct TransformState {
+      Mat4 projectionView;
+      Vec2 translation;
+      bool translationOnly;
+    };
+    std::vector<TransformState> mTransforms;
+
+    // Sum of the pushed translations, while there are only translations.
+    Vec2 mTranslation{0.0f};
+    bool mTranslationOnly = true;
+
+    std::vector<f32> mOpacities;
+    f32 mOpacity = 1.0f;
+
+    // The target drawn into and what beginTarget() replaced.
+    struct TargetState {
+      FrameBuffer::Handle target;
+      u32 width;
+      u32 height;
+      Mat4 projectionView;
+      std::vector<ClipRect> clips;
+      std::vector<TransformState> transforms;
+      Vec2 translation;
+      bool translationOnly;
+      std::vector<f32> opacities;
+      f32 opacity;
+    };
+    std::vector<TargetState> mTargets;
+
     // Font rendering
     TextureAtlas mFontAtlas;
   };
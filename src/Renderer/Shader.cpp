@@ -4,6 +4,7 @@
 
 #include "Core/OpenGL.hpp"
 #include "Renderer/Shader.hpp"
+#include "Renderer/GLState.hpp"
 #include "Utils/String.hpp"
 
 #include <cstring>
@@ -267,7 +268,7 @@ namespace Gui {
       Logger::trace("Shader: Materials block binding at 2");
     }
 
-    return std::make_shared<Shader>(shaderProgram, mAsset);
+    return makeRef<Shader>(shaderProgram, mAsset);
   }
 
   u32 Shader::compile(Type type, const char* source) noexcept {
@@ -295,7 +296,7 @@ namespace Gui {
   }
 
   Shader::~Shader() {
-    glDeleteProgram(id);
+    GLState::get().deleteProgram(id);
   }
 
   bool Shader::reload() {
@@ -318,11 +319,11 @@ namespace Gui {
   }
 
   void Shader::bind() noexcept {
-    glUseProgram(id);
+    GLState::get().useProgram(id);
   }
 
   void Shader::unbind() noexcept {
-    glUseProgram(NULL_SHADER);
+    GLState::get().useProgram(NULL_SHADER);
   }
 
   i32 Shader::getUniformLocation(StringView string) {
@@ -7,7 +7,7 @@
 
 namespace Gui {
 
-  class Shader {
+  class Shader : public RefCounted {
   public:
     enum class Type {
       Vertex = 0,
@@ -22,7 +22,7 @@ namespace Gui {
       Core330,
     };
 
-    using Handle = std::shared_ptr<Shader>;
+    using Handle = Ref<Shader>;
 
     class Builder {
       friend class Shader;
@@ -74,7 +74,7 @@ namespace Gui {
   public:
     // DO NOT USE! Use the shader builder.
     //
-    // NOTE: Has to be public to be constructed with std::make_shared
+    // NOTE: Has to be public to be constructed with makeRef()
     Shader(u32 id, Asset::Handle asset)
       : id{id}, mAsset{std::move(asset)}
     {}
@@ -1,4 +1,8 @@
-#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <vector>
 #include <glm/gtc/matrix_transform.hpp>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -6,14 +10,84 @@
 #include "Core/OpenGL.hpp"
 
 #include "Renderer/Texture.hpp"
+#include "Renderer/GLState.hpp"
 #include "Renderer/Shader.hpp"
+#include "Renderer/TextureCache.hpp"
+#include "Core/ThreadPool.hpp"
 
 namespace Gui {
 
-  // TODO: key should also have specification
-  // FIXME: Delete texture when it reaches 1 refcount for hashmap
-  static std::unordered_map<String, Texture::Handle> cachedImageTexture; // Key: Path,  Value: Texture
-  static std::unordered_map<u32,    Texture::Handle> cachedColorTexture; // Key: Color, Value: Texture
+
+  namespace {
+    struct DecodedImage {
+      u64 ticket = 0;
+      stbi_uc* bytes = nullptr;
+      int width = 0;
+      int height = 0;
+      int channels = 0;
+    };
+
+    struct PendingTexture {
+      u64 ticket;
+      Texture::Handle texture;
+      Texture::Builder builder;
+    };
+
+    // Safe to call from any thread.
+    bool decodeImage(const u8* data, usize size, const String& path, bool verticalFlip, DecodedImage& image) {
+      // Once set on a thread, stb ignores the global setting there, so every
+      // decode in the library sets the per thread one.
+      stbi_set_flip_vertically_on_load_thread(verticalFlip);
+      image.bytes = stbi_load_from_memory(data, (int)size, &image.width, &image.height, &image.channels, 0);
+      if (!image.bytes) {
+        Logger::error("Couldn't decode image file '%s'", path.c_str());
+        return false;
+      }
+
+      if (image.channels != 4 && image.channels != 3) {
+        Logger::error("Unsupported channel count %d in image file '%s'", image.channels, path.c_str());
+        stbi_image_free(image.bytes);
+        image.bytes = nullptr;
+        return false;
+      }
+      return true;
+    }
+
+    // Only on the GL thread, loading an Asset replaces its data without locking.
+    bool decodeImage(const Asset::Handle& asset, bool verticalFlip, DecodedImage& image) {
+      if (!asset->load()) {
+        Logger::error("Couldn't load image file '%s'", asset->filepath().c_str());
+        return false;
+      }
+      return decodeImage(asset->data(), asset->size(), asset->filepath(), verticalFlip, image);
+    }
+
+    // For the workers, reads the file into a buffer of their own.
+    bool readFile(const String& path, std::vector<u8>& data) {
+      std::FILE* file = std::fopen(path.c_str(), "rb");
+      if (!file) {
+        Logger::error("Couldn't load image file '%s'", path.c_str());
+        return false;
+      }
+
+      u8 chunk[4096];
+      usize count;
+      while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + count);
+      }
+      std::fclose(file);
+      return true;
+    }
+  }
+
+  // Textures waiting for their image, only touched on the GL thread.
+  static std::vector<PendingTexture> pendingTextures;
+  static std::deque<DecodedImage> uploadQueue;
+  static u64 nextTicket = 0;
+
+  // Filled by the workers.
+  static std::mutex decodedMutex;
+  static std::vector<DecodedImage> decodedImages;
 
   static const u8 defaultTextureData[] = {
     0x00, 0x00, 0x00, 0xFF,   0xFF, 0x00, 0xFF, 0xFF,
@@ -105,6 +179,35 @@ namespace Gui {
     GUI_UNREACHABLE("unknown internal format type!");
   }
 
+  static usize TextureInternalFormatByteSize(Texture::Format format) {
+    switch (format) {
+      case Texture::Format::Rgb8:            return 3;
+      case Texture::Format::Rgba8:           return 4;
+      case Texture::Format::Rgba8UI:         return 4;
+      case Texture::Format::Srgb8:           return 3;
+      case Texture::Format::Srgb8Alpha8:     return 4;
+      case Texture::Format::Rgb32F:          return 12;
+      case Texture::Format::Rgb16F:          return 6;
+      case Texture::Format::Rgba32F:         return 16;
+      case Texture::Format::Rgba16F:         return 8;
+      case Texture::Format::R11FG11FB10F:    return 4;
+      case Texture::Format::R32UI:           return 4;
+      case Texture::Format::Depth24Stencil8: return 4;
+    }
+    GUI_UNREACHABLE("unknown internal format type!");
+  }
+
+  static usize TextureByteSize(u32 width, u32 height, const Texture::Specification& specification) {
+    usize size = (usize)width * height * TextureInternalFormatByteSize(specification.internalFormat);
+    if (specification.samples != 0) {
+      size *= specification.samples;
+    } else if (specification.mipmap != Texture::MipmapMode::None) {
+      // The mipmap chain adds a third.
+      size += size / 3;
+    }
+    return size;
+  }
+
   static Texture::DataFormat TextureBaseDataFormatOfInternalFomat(Texture::Format format) {
     switch (format) {
       case Texture::Format::Rgb8:            return Texture::DataFormat::Rgb;
@@ -169,11 +272,17 @@ namespace Gui {
     mSpecification.samples = inSamples;
     return *this;
   }
+  Texture::Builder& Texture::Builder::streaming(bool yes) {
+    mSpecification.streaming = yes;
+    return *this;
+  }
   Texture::Handle Texture::Builder::build() {
+    Option<TextureCache::Key> key;
     switch (mType) {
       case Texture::Type::Color:
-        if (cachedColorTexture.find(mColor) != cachedColorTexture.end()) {
-          return cachedColorTexture.at(mColor);
+        key = TextureCache::Key::forColor(mColor, mSpecification);
+        if (auto texture = TextureCache::get().find(*key)) {
+          return texture;
         }
         break;
       case Texture::Type::Buffer:
@@ -183,8 +292,9 @@ namespace Gui {
         }
         break;
       case Texture::Type::Image:
-        if (cachedImageTexture.find(mAsset->filepath()) != cachedImageTexture.end()) {
-          return cachedImageTexture.at(mAsset->filepath());
+        key = TextureCache::Key::forImage(mAsset->filepath(), mSpecification);
+        if (auto texture = TextureCache::get().find(*key)) {
+          return texture;
         }
         break;
       default:
@@ -193,30 +303,136 @@ namespace Gui {
 
     mSpecification.type = mType;
 
+    DecodedImage image;
     if (mType == Texture::Type::Image) {
-      stbi_set_flip_vertically_on_load(mSpecification.verticalFlip);
-
-      if (!mAsset->load()) {
-        Logger::error("Couldn't load image file '%s'", mAsset->filepath().c_str());
+      if (!decodeImage(mAsset, mSpecification.verticalFlip, image)) {
         return {};
       }
+      setImage(image.bytes, image.width, image.height, image.channels);
+    }
+
+    auto data = createTexture();
+
+    // The pixels are on the GPU now.
+    if (image.bytes) {
+      stbi_image_free(image.bytes);
+      mData = nullptr;
+    }
+
+    auto handle = makeRef<Texture>(std::move(data));
+    switch (mType) {
+      case Texture::Type::Color:
+        Logger::trace("Texture #%u created color: #%08X", handle->getId(), handle->getColor());
+        TextureCache::get().insert(std::move(*key), handle);
+        break;
+      case Texture::Type::Image:
+        Logger::trace("Texture #%u loaded from file: %s", handle->getId(), handle->getFilePath()->c_str());
+        TextureCache::get().insert(std::move(*key), handle);
+        break;
+      case Texture::Type::Buffer:
+        Logger::trace("Texture #%u created buffer: width=%u, height=%u", handle->getId(), handle->getWidth(), handle->getHeight());
+        break;
+      default:
+        GUI_UNREACHABLE("unknown texture type!");
+    }
+    return handle;
+  }
+
+  Texture::Handle Texture::Builder::buildAsync() {
+    if (mType != Texture::Type::Image) {
+      return build();
+    }
+
+    auto key = TextureCache::Key::forImage(mAsset->filepath(), mSpecification);
+    if (auto texture = TextureCache::get().find(key)) {
+      return texture;
+    }
+
+    mSpecification.type = mType;
+
+    auto texture = Texture::generateMissingDataPlaceholder();
+    texture->mData.type    = Texture::Type::Image;
+    texture->mData.asset   = mAsset;
+    texture->mData.loading = true;
+    TextureCache::get().insert(std::move(key), texture);
+
+    const u64 ticket = ++nextTicket;
+    pendingTextures.push_back({ticket, texture, *this});
+
+    // The worker must not touch the texture handle, its count isn't atomic,
+    // nor load the asset, other loads of it may run at the same time. The
+    // data of embedded assets never changes, files are read anew.
+    ThreadPool::get().submit([ticket, asset = mAsset, verticalFlip = mSpecification.verticalFlip] {
+      DecodedImage image;
+      image.ticket = ticket;
+      if (asset->isEmbedded()) {
+        decodeImage(asset->data(), asset->size(), asset->filepath(), verticalFlip, image);
+      } else {
+        std::vector<u8> data;
+        if (readFile(asset->filepath(), data)) {
+          decodeImage(data.data(), data.size(), asset->filepath(), verticalFlip, image);
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(decodedMutex);
+      decodedImages.push_back(image);
+    });
+    return texture;
+  }
+
+  void Texture::uploadPending(usize budget) {
+    if (pendingTextures.empty()) {
+      return;
+    }
 
-      int width, height, channels;
-      stbi_uc* bytes = stbi_load_from_memory(mAsset->data(), mAsset->size(), &width, &height, &channels, 0);
+    {
+      std::lock_guard<std::mutex> lock(decodedMutex);
+      uploadQueue.insert(uploadQueue.end(), decodedImages.begin(), decodedImages.end());
+      decodedImages.clear();
+    }
 
-      mWidth  = width;
-      mHeight = height;
-      mData   = bytes;
-      mDataType = Texture::DataType::UnsignedByte;
+    usize uploaded = 0;
+    while (!uploadQueue.empty() && uploaded < budget) {
+      auto image = uploadQueue.front();
+      uploadQueue.pop_front();
+
+      auto it = std::find_if(pendingTextures.begin(), pendingTextures.end(), [&](const PendingTexture& pending) {
+        return pending.ticket == image.ticket;
+      });
+      // Issued before destroyAllTextures().
+      if (it == pendingTextures.end()) {
+        stbi_image_free(image.bytes);
+        continue;
+      }
 
-      GUI_ASSERT_WITH_MESSAGE(channels == 4 || channels == 3, "Unknown channel");
-      if (channels == 4) {
-        mDataFormat = Texture::DataFormat::Rgba;
-      } else if (channels == 3) {
-        mDataFormat = Texture::DataFormat::Rgb;
+      auto& texture = *it->texture;
+      if (image.bytes) {
+        it->builder.setImage(image.bytes, image.width, image.height, image.channels);
+        auto data = it->builder.createTexture();
+        stbi_image_free(image.bytes);
+
+        GLState::get().deleteTexture(texture.mData.id);
+        TextureCache::get().resized(texture.mData.byteSize, data.byteSize);
+        texture.mData = std::move(data);
+        uploaded += (usize)image.width * (usize)image.height * (usize)image.channels;
+        Logger::trace("Texture #%u loaded from file: %s", texture.getId(), texture.getFilePath()->c_str());
       }
+
+      // On failure the placeholder stays.
+      texture.mData.loading = false;
+      pendingTextures.erase(it);
     }
+  }
+
+  void Texture::Builder::setImage(const void* pixels, u32 width, u32 height, u32 channels) {
+    mWidth      = width;
+    mHeight     = height;
+    mData       = pixels;
+    mDataType   = Texture::DataType::UnsignedByte;
+    mDataFormat = channels == 4 ? Texture::DataFormat::Rgba : Texture::DataFormat::Rgb;
+  }
 
+  Texture::Data Texture::Builder::createTexture() {
     GUI_ASSERT(mWidth != 0 || mHeight != 0);
 
     if (mSpecification.gammaCorrected) {
@@ -243,7 +459,7 @@ namespace Gui {
 
     u32 texture;
     glGenTextures(1, &texture);
-    glBindTexture(target, texture);
+    GLState::get().bindTexture(0, target, texture);
 
     // set the texture wrapping/filtering options (on the currently bound texture object)
     glTexParameteri(target, GL_TEXTURE_WRAP_S, wrapping);
@@ -283,34 +499,29 @@ namespace Gui {
       glGenerateMipmap(target);
     }
 
-    // TODO: Maybe unload image
-    // if (mType == Texture::Type::Image) {
-    //   stbi_image_free((stbi_uc*)mData);
-    // }
-
     auto data = Data{texture, mWidth, mHeight, mSpecification, mType, mAsset, mColor};
-    auto handle = std::make_shared<Texture>(std::move(data));
-    switch (mType) {
-      case Texture::Type::Color:
-        Logger::trace("Texture #%u created color: #%08X", handle->getId(), handle->getColor());
-        cachedColorTexture.emplace(mColor, handle);
-        break;
-      case Texture::Type::Image:
-        Logger::trace("Texture #%u loaded from file: %s", handle->getId(), handle->getFilePath()->c_str());
-        cachedImageTexture.emplace(*handle->getFilePath(), handle);
-        break;
-      case Texture::Type::Buffer:
-        Logger::trace("Texture #%u created buffer: width=%u, height=%u", handle->getId(), handle->getWidth(), handle->getHeight());
-        break;
-      default:
-        GUI_UNREACHABLE("unknown texture type!");
+    data.byteSize = TextureByteSize(mWidth, mHeight, mSpecification);
+    if (mSpecification.streaming && mSpecification.samples == 0) {
+      data.pixelBuffers = PixelBufferRing::create((usize)mWidth * mHeight * 4);
     }
-    return handle;
+    return data;
   }
 
   void Texture::destroyAllTextures() {
-    cachedImageTexture.clear();
-    cachedColorTexture.clear();
+    pendingTextures.clear();
+    for (auto& image : uploadQueue) {
+      stbi_image_free(image.bytes);
+    }
+    uploadQueue.clear();
+    {
+      std::lock_guard<std::mutex> lock(decodedMutex);
+      for (auto& image : decodedImages) {
+        stbi_image_free(image.bytes);
+      }
+      decodedImages.clear();
+    }
+
+    TextureCache::get().clear();
   }
 
   void Texture::reloadAll() {
@@ -342,7 +553,7 @@ namespace Gui {
 
     u32 texture;
     glGenTextures(1, &texture);
-    glBindTexture(GL_TEXTURE_2D, texture);
+    GLState::get().bindTexture(0, GL_TEXTURE_2D, texture);
 
     // set the texture wrapping/filtering options (on the currently bound texture object)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapping);
@@ -355,7 +566,9 @@ namespace Gui {
       glGenerateMipmap(GL_TEXTURE_2D);
     }
 
-    return Data{texture, width, height, specification, Texture::Type::Color};
+    auto data = Data{texture, width, height, specification, Texture::Type::Color};
+    data.byteSize = TextureByteSize(width, height, specification);
+    return data;
   }
   Texture::Builder Texture::color(u32 color) {
     Builder builder;
@@ -408,7 +621,7 @@ namespace Gui {
       return true;
     }
 
-    stbi_set_flip_vertically_on_load(mData.specification.verticalFlip);
+    stbi_set_flip_vertically_on_load_thread(mData.specification.verticalFlip);
     // int width, height, channels;
     // auto file = *mData.filePath;
     // u8* bytes = stbi_load(mData.filePath->c_str(), &width, &height, &channels, 0);
@@ -442,13 +655,24 @@ namespace Gui {
       default:
         GUI_UNREACHABLE("unknown texture type!");
     }
-    glDeleteTextures(1, &mData.id);
+    GLState::get().deleteTexture(mData.id);
   }
   void Texture::bind(const usize slot) const {
-    // TODO: debug check if max texture slot reached
-    u32 textureId = mData.id;
-    glActiveTexture(GL_TEXTURE0 + (GLenum)slot);
-    glBindTexture(GL_TEXTURE_2D, textureId);
+    GLState::get().bindTexture((u32)slot, GL_TEXTURE_2D, mData.id);
+  }
+  void Texture::update(const Region& region, const void* pixels) {
+    GUI_DEBUG_ASSERT(region.x + region.width <= mData.width && region.y + region.height <= mData.height);
+    GLState::get().bindTexture(0, GL_TEXTURE_2D, mData.id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    if (!mData.pixelBuffers) {
+      glTexSubImage2D(GL_TEXTURE_2D, 0, region.x, region.y, region.width, region.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+      return;
+    }
+
+    const usize offset = mData.pixelBuffers->write(pixels, (usize)region.width * region.height * 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, region.x, region.y, region.width, region.height, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)offset);
+    mData.pixelBuffers->submit();
   }
   u32 Texture::getId() const {
     return mData.id;
@@ -479,7 +703,13 @@ namespace Gui {
     mColumnCellCount = textureHeight / mCellHeight;
   }
 
-  SubTexture TextureAtlas::get(u32 _index) {
+  SubTexture TextureAtlas::get(u32 index) {
+    Vec2 from, to;
+    getTextureCoordinates(index, from, to);
+    return SubTexture(mTexture, from, to);
+  }
+
+  void TextureAtlas::getTextureCoordinates(u32 _index, Vec2& from, Vec2& to) const {
     u32 level = _index / mRowCellCount;
     u32 index = _index % mRowCellCount;
 
@@ -492,17 +722,14 @@ namespace Gui {
     const auto widthRatio  = f32(mCellWidth) / textureWidth;
     const auto heightRatio = f32(mCellHeight) / textureHeight;
 
-    return SubTexture(
-      mTexture,
-      { // from
-        widthRatio * index,
-        heightRatio * (mColumnCellCount - level - 1)
-      },
-      { // to
-        widthRatio * (index + 1),
-        heightRatio * (mColumnCellCount - level)
-      }
-    );
+    from = {
+      widthRatio * index,
+      heightRatio * (mColumnCellCount - level - 1)
+    };
+    to = {
+      widthRatio * (index + 1),
+      heightRatio * (mColumnCellCount - level)
+    };
   }
 
 } // namespace Gui
@@ -2,13 +2,16 @@
 
 #include "Core/Base.hpp"
 #include "Asset.hpp"
+#include "Renderer/PixelBufferRing.hpp"
 
 namespace Gui {
 
-  class Texture {
+  class Texture : public RefCounted {
     friend class Application;
+    struct Data;
+
   public:
-    using Handle = std::shared_ptr<Texture>;
+    using Handle = Ref<Texture>;
 
     enum class WrappingMode : u8 {
       Repeat,
@@ -98,6 +101,11 @@ namespace Gui {
       bool                    verticalFlip   = true;
       bool                    gammaCorrected = true;
       u32                     samples        = 0;
+      bool                    streaming      = false;
+    };
+
+    struct Region {
+      u32 x, y, width, height;
     };
 
     class Builder {
@@ -109,11 +117,21 @@ namespace Gui {
       Builder& verticalFlipOnLoad(bool yes = true);
       Builder& gammaCorrected(bool yes = true);
       Builder& samples(u32 inSamples);
+
+      // Allocates a PixelBufferRing, for textures updated every frame.
+      Builder& streaming(bool yes = true);
       Texture::Handle build();
 
+      // Decodes the image on the ThreadPool. The returned texture shows the
+      // missing data placeholder until Texture::uploadPending() uploads it.
+      Texture::Handle buildAsync();
+
     private:
       Builder() = default;
 
+      void setImage(const void* pixels, u32 width, u32 height, u32 channels);
+      Texture::Data createTexture();
+
     private:
       Texture::Type mType = Texture::Type::Color;
 
@@ -146,6 +164,15 @@ namespace Gui {
 
     void bind(const usize slot = 0) const;
 
+    // Uploads tightly packed RGBA8 pixels into a region of the texture. Streaming
+    // textures go through their pixel buffers and don't stall.
+    void update(const Region& region, const void* pixels);
+    inline void update(u32 x, u32 y, u32 width, u32 height, const void* pixels) {
+      update(Region{x, y, width, height}, pixels);
+    }
+
+    inline const PixelBufferRing::Handle& getPixelBuffers() const { return mData.pixelBuffers; }
+
     u32 getId() const;
     u32 getWidth() const;
     u32 getHeight() const;
@@ -162,8 +189,19 @@ namespace Gui {
     inline Texture::Type getType() const { return mData.type; }
     inline u32 getColor() const { return mData.color; }
 
+    // Estimated GPU memory, including mipmaps and samples.
+    inline usize getByteSize() const { return mData.byteSize; }
+
     static void reloadAll();
 
+    inline bool isLoading() const { return mData.loading; }
+
+    static constexpr const usize DEFAULT_UPLOAD_BUDGET = 8 * 1024 * 1024;
+
+    // Uploads the images decoded by buildAsync(), stopping once `budget`
+    // bytes were uploaded. Called by the application every frame.
+    static void uploadPending(usize budget = DEFAULT_UPLOAD_BUDGET);
+
   private:
     struct Data {
       u32 id;
@@ -174,6 +212,9 @@ namespace Gui {
       Texture::Type type;
       Asset::Handle asset = nullptr;
       u32 color{};
+      bool loading = false;
+      PixelBufferRing::Handle pixelBuffers = nullptr;
+      usize byteSize = 0;
     };
 
     static Data fromBytes(const u8 bytes[], const u32 width, const u32 height, const u32 channels = 4, Specification specification = {});
@@ -183,7 +224,7 @@ namespace Gui {
   public:
     // DO NOT USE! Use the builder!
     //
-    // NOTE: It has to be public so it can be constructed by std::make_shared.
+    // NOTE: It has to be public so it can be constructed by makeRef().
     Texture(Data data)
       : mData{std::move(data)}
     {}
@@ -217,6 +258,10 @@ namespace Gui {
 
     SubTexture get(u32 index);
 
+    // Same as get() but only computes the texture coordinates, without touching the texture handle.
+    void getTextureCoordinates(u32 index, Vec2& from, Vec2& to) const;
+    inline const Texture::Handle& getTexture() const { return mTexture; }
+
   private:
     Texture::Handle mTexture = nullptr;
     u32 mCellWidth{};
@@ -0,0 +1,92 @@
+#include <stb_image.h>
+
+#include "Core/OpenGL.hpp"
+#include "Renderer/TextureArray.hpp"
+#include "Renderer/GLState.hpp"
+
+namespace Gui {
+
+  TextureArray::Handle TextureArray::create(u32 layerWidth, u32 layerHeight, u32 layerCount, Texture::FilteringMode filtering, bool gammaCorrected) {
+    GUI_ASSERT(layerWidth != 0 && layerHeight != 0);
+    GUI_ASSERT_WITH_MESSAGE(layerCount != 0 && layerCount <= MAX_LAYERS, "invalid texture array layer count");
+
+    const GLenum filter = filtering == Texture::FilteringMode::Nearest ? GL_NEAREST : GL_LINEAR;
+
+    u32 id;
+    glGenTextures(1, &id);
+    GLState::get().bindTexture(0, GL_TEXTURE_2D_ARRAY, id);
+
+    // No mipmaps, images only cover part of their layer.
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, filter);
+
+    const GLenum internalFormat = gammaCorrected ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, internalFormat, layerWidth, layerHeight, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    Logger::trace("Texture array #%u created: %ux%u, %u layers", id, layerWidth, layerHeight, layerCount);
+    return makeRef<TextureArray>(id, layerWidth, layerHeight, layerCount);
+  }
+
+  TextureArray::~TextureArray() {
+    Logger::trace("Texture array #%u destroyed", mId);
+    GLState::get().deleteTexture(mId);
+  }
+
+  Option<TextureArray::Image> TextureArray::add(const void* pixels, u32 width, u32 height) {
+    if (width > mLayerWidth || height > mLayerHeight) {
+      Logger::error("Image %ux%u does not fit in a %ux%u texture array layer", width, height, mLayerWidth, mLayerHeight);
+      return None;
+    }
+    if (mUsedLayerCount == mLayerCount) {
+      return None;
+    }
+
+    const u32 layer = mUsedLayerCount++;
+    GLState::get().bindTexture(0, GL_TEXTURE_2D_ARRAY, mId);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+    // The rest of the layer is undefined, keep linear filtering from reaching
+    // into it by insetting the coordinates by half a texel.
+    const Vec2 layerSize = {(f32)mLayerWidth, (f32)mLayerHeight};
+    Vec2 from = {0.0f, 0.0f};
+    Vec2 to   = {(f32)width / layerSize.x, (f32)height / layerSize.y};
+    if (width < mLayerWidth) {
+      from.x += 0.5f / layerSize.x;
+      to.x   -= 0.5f / layerSize.x;
+    }
+    if (height < mLayerHeight) {
+      from.y += 0.5f / layerSize.y;
+      to.y   -= 0.5f / layerSize.y;
+    }
+
+    return Image(TextureArray::Handle(this), layer, from, to);
+  }
+
+  Option<TextureArray::Image> TextureArray::load(const Asset::Handle& asset, bool verticalFlipOnLoad) {
+    if (!asset->load()) {
+      Logger::error("Couldn't load image file '%s'", asset->filepath().c_str());
+      return None;
+    }
+
+    stbi_set_flip_vertically_on_load_thread(verticalFlipOnLoad);
+
+    int width, height, channels;
+    stbi_uc* bytes = stbi_load_from_memory(asset->data(), (int)asset->size(), &width, &height, &channels, 4);
+    if (!bytes) {
+      Logger::error("Couldn't decode image file '%s'", asset->filepath().c_str());
+      return None;
+    }
+
+    auto image = add(bytes, (u32)width, (u32)height);
+    stbi_image_free(bytes);
+    return image;
+  }
+
+  void TextureArray::bind(u32 unit) const {
+    GLState::get().bindTexture(unit, GL_TEXTURE_2D_ARRAY, mId);
+  }
+
+} // namespace Gui
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Core/Base.hpp"
+#include "Renderer/Texture.hpp"
+
+#include <Asset.hpp>
+
+namespace Gui {
+
+  // GL_TEXTURE_2D_ARRAY of same-sized RGBA layers, one image per layer.
+  //
+  // Every image of an array can be drawn in the same batch, see
+  // Renderer2D::drawImage(), so it is meant for icon sets and thumbnails that
+  // would otherwise exhaust the texture slots of a batch.
+  class TextureArray : public RefCounted {
+  public:
+    using Handle = Ref<TextureArray>;
+
+    // Region of a layer holding one image.
+    class Image {
+    public:
+      Image() = default;
+      Image(TextureArray::Handle array, u32 layer, const Vec2& from, const Vec2& to)
+        : mArray{std::move(array)}, mLayer{layer}, mFrom{from}, mTo{to}
+      {}
+
+      inline const TextureArray::Handle& getArray() const { return mArray; }
+      inline u32 getLayer() const { return mLayer; }
+      inline const Vec2& getFrom() const { return mFrom; }
+      inline const Vec2& getTo() const { return mTo; }
+
+    private:
+      TextureArray::Handle mArray;
+      u32 mLayer = 0;
+      Vec2 mFrom{0.0f, 0.0f};
+      Vec2 mTo{1.0f, 1.0f};
+    };
+
+    // Guaranteed by OpenGL 3.3 and OpenGL ES 3.0.
+    static constexpr const u32 MAX_LAYERS = 256;
+
+  public:
+    [[nodiscard]] static TextureArray::Handle create(u32 layerWidth, u32 layerHeight, u32 layerCount, Texture::FilteringMode filtering = Texture::FilteringMode::Linear, bool gammaCorrected = true);
+    DISALLOW_MOVE_AND_COPY(TextureArray);
+    ~TextureArray();
+
+    // Uploads tightly packed RGBA8 pixels into the next free layer. Returns None
+    // if the image is larger than a layer or the array is full.
+    Option<Image> add(const void* pixels, u32 width, u32 height);
+    Option<Image> load(const Asset::Handle& asset, bool verticalFlipOnLoad = true);
+
+    void bind(u32 unit = 0) const;
+
+    inline u32 getId() const { return mId; }
+    inline u32 getLayerWidth() const { return mLayerWidth; }
+    inline u32 getLayerHeight() const { return mLayerHeight; }
+    inline u32 getLayerCount() const { return mLayerCount; }
+    inline u32 getUsedLayerCount() const { return mUsedLayerCount; }
+
+  public:
+    // DO NOT USE! Use TextureArray::create()
+    //
+    // NOTE: It has to be public so it can be constructed by makeRef().
+    TextureArray(u32 id, u32 layerWidth, u32 layerHeight, u32 layerCount)
+      : mId{id}, mLayerWidth{layerWidth}, mLayerHeight{layerHeight}, mLayerCount{layerCount}
+    {}
+
+  private:
+    u32 mId;
+    u32 mLayerWidth;
+    u32 mLayerHeight;
+    u32 mLayerCount;
+    u32 mUsedLayerCount = 0;
+  };
+
+} // namespace Gui
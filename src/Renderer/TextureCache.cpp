@@ -0,0 +1,101 @@
+#include "Renderer/TextureCache.hpp"
+
+#include <functional>
+
+namespace Gui {
+
+  namespace {
+    u64 packSpecification(const Texture::Specification& specification) {
+      u64 result = 0;
+      result = (result << 8) | (u64)specification.internalFormat;
+      result = (result << 8) | (u64)specification.wrapping;
+      result = (result << 8) | (u64)specification.filtering.min;
+      result = (result << 8) | (u64)specification.filtering.mag;
+      result = (result << 8) | (u64)specification.mipmap;
+      result = (result << 8) | (u64)specification.samples;
+      result = (result << 1) | (u64)specification.verticalFlip;
+      result = (result << 1) | (u64)specification.gammaCorrected;
+      result = (result << 1) | (u64)specification.streaming;
+      return result;
+    }
+  }
+
+  TextureCache::Key TextureCache::Key::forImage(const String& path, const Texture::Specification& specification) {
+    return Key{Texture::Type::Image, path, 0, packSpecification(specification)};
+  }
+
+  TextureCache::Key TextureCache::Key::forColor(u32 color, const Texture::Specification& specification) {
+    return Key{Texture::Type::Color, String(), color, packSpecification(specification)};
+  }
+
+  usize TextureCache::KeyHash::operator()(const Key& key) const {
+    usize hash = std::hash<String>{}(key.path);
+    hash ^= std::hash<u64>{}(key.specification) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<u32>{}(key.color)         + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+
+  TextureCache& TextureCache::get() {
+    static TextureCache cache;
+    return cache;
+  }
+
+  Texture::Handle TextureCache::find(const Key& key) {
+    auto it = mIndex.find(key);
+    if (it == mIndex.end()) {
+      mStats.misses++;
+      return nullptr;
+    }
+
+    mStats.hits++;
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return it->second->texture;
+  }
+
+  void TextureCache::insert(Key key, Texture::Handle texture) {
+    GUI_DEBUG_ASSERT(mIndex.find(key) == mIndex.end());
+
+    mStats.residentBytes += texture->getByteSize();
+    mStats.entries++;
+    mEntries.push_front({std::move(key), std::move(texture)});
+    mIndex.emplace(mEntries.front().key, mEntries.begin());
+
+    trim();
+  }
+
+  void TextureCache::trim() {
+    if (mStats.residentBytes <= mBudget) {
+      return;
+    }
+
+    for (auto it = mEntries.end(); it != mEntries.begin() && mStats.residentBytes > mBudget;) {
+      --it;
+      if (it->texture.getRefCount() != 1) {
+        continue;
+      }
+
+      mStats.residentBytes -= it->texture->getByteSize();
+      mStats.entries--;
+      mStats.evictions++;
+      mIndex.erase(it->key);
+      it = mEntries.erase(it);
+    }
+  }
+
+  void TextureCache::clear() {
+    mIndex.clear();
+    mEntries.clear();
+    mStats.residentBytes = 0;
+    mStats.entries = 0;
+  }
+
+  void TextureCache::setBudget(usize bytes) {
+    mBudget = bytes;
+    trim();
+  }
+
+  void TextureCache::resized(usize oldBytes, usize newBytes) {
+    mStats.residentBytes = mStats.residentBytes - oldBytes + newBytes;
+  }
+
+} // namespace Gui
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Core/Base.hpp"
+#include "Renderer/Texture.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace Gui {
+
+  // Image and color textures created by Texture::Builder, keyed by their source
+  // and specification, most recently used first.
+  //
+  // Once the textures take more GPU memory than the budget, the least
+  // recently used ones that nothing outside the cache references are
+  // destroyed. Referenced textures are never evicted, so the budget can be
+  // exceeded while they are in use.
+  class TextureCache {
+  public:
+    static constexpr const usize DEFAULT_BUDGET = 256 * 1024 * 1024;
+
+    struct Stats {
+      u32 hits      = 0;
+      u32 misses    = 0;
+      u32 evictions = 0;
+      u32 entries   = 0;
+      usize residentBytes = 0;
+    };
+
+    struct Key {
+      Texture::Type type;
+      String path;
+      u32 color;
+
+      // Every field of the specification that changes the texture.
+      u64 specification;
+
+      static Key forImage(const String& path, const Texture::Specification& specification);
+      static Key forColor(u32 color, const Texture::Specification& specification);
+
+      bool operator==(const Key& other) const {
+        return type == other.type && color == other.color && specification == other.specification && path == other.path;
+      }
+    };
+
+  public:
+    static TextureCache& get();
+    DISALLOW_MOVE_AND_COPY(TextureCache);
+
+    // Returns the cached texture, marking it as most recently used.
+    Texture::Handle find(const Key& key);
+    void insert(Key key, Texture::Handle texture);
+
+    // Evicts unreferenced textures until the resident bytes fit the budget.
+    void trim();
+    void clear();
+
+    void setBudget(usize bytes);
+    inline usize getBudget() const { return mBudget; }
+    inline const Stats& getStats() const { return mStats; }
+
+  private:
+    TextureCache() = default;
+
+    // A cached texture changed size, e.g. an asynchronously loaded image
+    // replacing its placeholder.
+    void resized(usize oldBytes, usize newBytes);
+
+  private:
+    struct KeyHash {
+      usize operator()(const Key& key) const;
+    };
+
+    struct Entry {
+      Key key;
+      Texture::Handle texture;
+    };
+
+    std::list<Entry> mEntries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> mIndex;
+    usize mBudget = DEFAULT_BUDGET;
+    Stats mStats;
+
+    friend class Texture;
+  };
+
+} // namespace Gui
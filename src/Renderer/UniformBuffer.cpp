@@ -1,4 +1,5 @@
 #include "Core/OpenGL.hpp"
+#include "Renderer/GLState.hpp"
 #include "Renderer/UniformBuffer.hpp"
 
 namespace Gui {
@@ -56,28 +57,28 @@ namespace Gui {
 
     u32 id;
     glGenBuffers(1, &id);
-    glBindBufferBase(GL_UNIFORM_BUFFER, mBinding, id);
+    GLState::get().bindBufferBase(GL_UNIFORM_BUFFER, mBinding, id);
     if (mData) {
       glBufferData(GL_UNIFORM_BUFFER, mSize, mData, storageAndAccess);
     } else {
       glBufferData(GL_UNIFORM_BUFFER, mSize, nullptr, storageAndAccess);
     }
-    return std::make_shared<UniformBuffer>(id, mSize, mBinding);
+    return makeRef<UniformBuffer>(id, mSize, mBinding);
   }
   UniformBuffer::Builder UniformBuffer::builder(u32 binding) {
     return UniformBuffer::Builder(binding);
   }
   UniformBuffer::~UniformBuffer() {
-    glDeleteBuffers(1, &mId);
+    GLState::get().deleteBuffer(mId);
   }
   void UniformBuffer::bind() {
-    glBindBuffer(GL_UNIFORM_BUFFER, mId);
+    GLState::get().bindBuffer(GL_UNIFORM_BUFFER, mId);
   }
   void UniformBuffer::unbind() {
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    GLState::get().bindBuffer(GL_UNIFORM_BUFFER, 0);
   }
   void UniformBuffer::set(const Slice<const void> slice) {
-    glBindBuffer(GL_UNIFORM_BUFFER, mId);
+    GLState::get().bindBuffer(GL_UNIFORM_BUFFER, mId);
     glBufferSubData(GL_UNIFORM_BUFFER, 0, slice.sizeInBytes(), slice.data());
   }
 
@@ -4,9 +4,9 @@
 
 namespace Gui {
 
-  class UniformBuffer {
+  class UniformBuffer : public RefCounted {
   public:
-    using Handle = std::shared_ptr<UniformBuffer>;
+    using Handle = Ref<UniformBuffer>;
 
     enum class StorageType : u8 {
       /// The data store contents will be modified once and used at most a few times.
@@ -67,7 +67,7 @@ namespace Gui {
   public:
     // DO NOT USE! Use the shader builder.
     //
-    // NOTE: Has to be public to be constructed with std::make_shared
+    // NOTE: Has to be public to be constructed with makeRef()
     UniformBuffer(u32 id, u32 size, u32 binding)
       : mId{id}, mSize(size), mBinding(binding)
     {}
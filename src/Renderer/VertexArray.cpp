@@ -1,4 +1,5 @@
 #include "Core/OpenGL.hpp"
+#include "Renderer/GLState.hpp"
 #include "Renderer/VertexArray.hpp"
 
 namespace Gui {
@@ -6,20 +7,20 @@ namespace Gui {
   VertexArray::Handle VertexArray::create() {
     u32 id;
     glGenVertexArrays(1, &id);
-    glBindVertexArray(id);
-    return std::make_shared<VertexArray>(id);
+    GLState::get().bindVertexArray(id);
+    return makeRef<VertexArray>(id);
   }
 
   VertexArray::~VertexArray() {
-    glDeleteVertexArrays(1, &mId);
+    GLState::get().deleteVertexArray(mId);
   }
 
   void VertexArray::bind() {
-    glBindVertexArray(mId);
+    GLState::get().bindVertexArray(mId);
   }
 
   void VertexArray::unbind() {
-    glBindVertexArray(0);
+    GLState::get().bindVertexArray(0);
   }
 
   void VertexArray::addVertexBuffer(VertexBuffer::Handle buffer) {
@@ -42,6 +43,9 @@ namespace Gui {
             (GLsizei)layout.getStride(),
             (const void*)element.getOffset()
           );
+          if (element.getAttributeDivisor() != 0) {
+            glVertexAttribDivisor(mVertexAttributeIndex, element.getAttributeDivisor());
+          }
           mVertexAttributeIndex++;
           break;
         case BufferElement::Type::Int:
@@ -127,7 +131,13 @@ namespace Gui {
     glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, 0);
   }
 
+  void VertexArray::drawIndicesInstanced(const u32 count, const u32 instances) {
+    this->bind();
+    glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, 0, instances);
+  }
+
   void VertexArray::drawArrays(u32 count) {
+    this->bind();
     glDrawArrays(GL_TRIANGLES, 0, count);
   }
 
@@ -7,9 +7,9 @@
 
 namespace Gui {
 
-  class VertexArray {
+  class VertexArray : public RefCounted {
   public:
-    using Handle = std::shared_ptr<VertexArray>;
+    using Handle = Ref<VertexArray>;
 
   public:
     [[nodiscard]] static VertexArray::Handle create();
@@ -26,13 +26,14 @@ namespace Gui {
 
     void drawIndices();
     void drawIndices(const u32 count);
+    void drawIndicesInstanced(const u32 count, const u32 instances);
 
     void drawArrays(u32 count);
 
   public:
     // DO NOT USE! Use the builder!
     //
-    // NOTE: It has to be public so it can be constructed by std::make_shared.
+    // NOTE: It has to be public so it can be constructed by makeRef().
     VertexArray(u32 id)
       : mId(id)
     {}
@@ -1,4 +1,5 @@
 #include "Core/OpenGL.hpp"
+#include "Renderer/GLState.hpp"
 #include "Renderer/VertexBuffer.hpp"
 
 namespace Gui {
@@ -111,28 +112,28 @@ namespace Gui {
 
     u32 id;
     glGenBuffers(1, &id);
-    glBindBuffer(GL_ARRAY_BUFFER, id);
+    GLState::get().bindBuffer(GL_ARRAY_BUFFER, id);
     if (mData) {
       glBufferData(GL_ARRAY_BUFFER, mSize, mData, storageAndAccess);
     } else {
       glBufferData(GL_ARRAY_BUFFER, mSize, nullptr, storageAndAccess);
     }
-    return std::make_shared<VertexBuffer>(id, BufferLayout(mLayout));
+    return makeRef<VertexBuffer>(id, BufferLayout(mLayout));
   }
   VertexBuffer::Builder VertexBuffer::builder() {
     return VertexBuffer::Builder();
   }
   VertexBuffer::~VertexBuffer() {
-    glDeleteBuffers(1, &mId);
+    GLState::get().deleteBuffer(mId);
   }
   void VertexBuffer::bind() {
-    glBindBuffer(GL_ARRAY_BUFFER, mId);
+    GLState::get().bindBuffer(GL_ARRAY_BUFFER, mId);
   }
   void VertexBuffer::unbind() {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::get().bindBuffer(GL_ARRAY_BUFFER, 0);
   }
   void VertexBuffer::set(const Slice<const void> slice) {
-    glBindBuffer(GL_ARRAY_BUFFER, mId);
+    GLState::get().bindBuffer(GL_ARRAY_BUFFER, mId);
     glBufferSubData(GL_ARRAY_BUFFER, 0, slice.sizeInBytes(), slice.data());
   }
 
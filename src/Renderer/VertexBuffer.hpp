@@ -95,9 +95,9 @@ namespace Gui {
     std::vector<BufferElement> elements;
   };
 
-  class VertexBuffer {
+  class VertexBuffer : public RefCounted {
   public:
-    using Handle = std::shared_ptr<VertexBuffer>;
+    using Handle = Ref<VertexBuffer>;
 
     class Builder {
     public:
@@ -139,7 +139,7 @@ namespace Gui {
   public:
     // DO NOT USE! Use the builder!
     //
-    // NOTE: It has to be public so it can be constructed by std::make_shared.
+    // NOTE: It has to be public so it can be constructed by makeRef().
     VertexBuffer(u32 id, BufferLayout layout)
       : mId{id}, mLayout{std::move(layout)}
     {}
@@ -6,13 +6,13 @@
 namespace Gui {
 
 Button::Handle Button::create(Widget::ClickCallback callback, std::string text, float fontSize) {
-  auto target = std::make_shared<Button>(std::move(text), fontSize);
+  auto target = makeWidget<Button>(std::move(text), fontSize);
   target->addClickEventHandler(std::move(callback));
   return target;
 }
 
 Button::Handle Button::create(std::string text, float fontSize) {
-  auto target = std::make_shared<Button>(std::move(text), fontSize);
+  auto target = makeWidget<Button>(std::move(text), fontSize);
   return target;
 }
 
@@ -16,21 +16,21 @@ public:
 
   Vec2 layout(Constraints constraints) override;
   void draw(Renderer2D& renderer) override;
-  bool visit(Widget::Handle self, Widget::Visitor& visitor) override { return visitor(self); }
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override { return visitor(self); }
 
-  inline void setText(std::string text) { mText = text; }
+  inline void setText(std::string text) { mText = text; markDirty(); }
   inline std::string getText() const { return mText; }
-  inline void setFontSize(float size) { mFontSize = size; }
+  inline void setFontSize(float size) { mFontSize = size; markDirty(); }
   inline float getFontSize() const { return mFontSize; }
-  inline void setColor(Vec4 color) { mColor = color; }
+  inline void setColor(Vec4 color) { mColor = color; markDirty(); }
   inline Vec4 getColor() const { return mColor; }
-  inline void setBackground(Vec4 color) { mBackground = color; }
+  inline void setBackground(Vec4 color) { mBackground = color; markDirty(); }
   inline Vec4 getBackground() const { return mBackground; }
-  inline void setMargin(Vec4 color) { mMargin = color; }
+  inline void setMargin(Vec4 color) { mMargin = color; markDirty(); }
   inline Vec4 getMargin() const { return mMargin; }
-  inline void setWidth(float size) { mWidth = size; }
+  inline void setWidth(float size) { mWidth = size; markDirty(); }
   inline float getWidth() const { return mWidth; }
-  inline void setHeight(float size) { mHeight = size; }
+  inline void setHeight(float size) { mHeight = size; markDirty(); }
   inline float getHeight() const { return mHeight; }
 
   static Button::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors);
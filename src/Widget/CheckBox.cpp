@@ -1,16 +1,18 @@
 #include "Widget/CheckBox.hpp"
 #include <Core/Color.hpp>
+#include <algorithm>
 #include <cctype>
 #include <cmath>
 
 namespace Gui {
 
 CheckBox::Handle CheckBox::create(OnChangeCallback callback) {
-  auto target = std::make_shared<CheckBox>(callback);
+  auto target = makeWidget<CheckBox>(callback);
   target->setOnChange(std::move(callback));
-  target->addClickEventHandler([target](auto) {
-    target->mValue = !target->mValue;
-    target->mOnChange(target->mValue);
+  auto self = target.get();
+  target->addClickEventHandler([self](auto) {
+    self->mValue = !self->mValue;
+    self->mOnChange(self->mValue);
     return true;
   });
   return target;
@@ -28,12 +30,12 @@ void CheckBox::draw(Renderer2D& renderer) {
   auto position = mPosition + Vec2{mMargin.x, mMargin.y};
   auto size     = mSize - Vec2{mMargin.x, mMargin.y} - Vec2{mMargin.z, mMargin.w};
 
-  if (mBackground != mBorderColor) {
-    renderer.drawQuad(position, size, mBorderColor);
-  }
-  auto borederOffset = size * 0.25f;
-  renderer.drawQuad(position + borederOffset / 2.0f, size - borederOffset, mBackground);
-  
+  RectStyle style;
+  style.color       = mBackground;
+  style.borderWidth = std::min(size.x, size.y) * 0.125f;
+  style.borderColor = mBorderColor;
+  renderer.drawRect(position, size, style);
+
   auto offset = size * 0.6f;
   if (mValue) {
     renderer.drawQuad(position + offset / 2.0f, size - offset, mColor);
@@ -16,19 +16,19 @@ public:
 
   Vec2 layout(Constraints constraints) override;
   void draw(Renderer2D& renderer) override;
-  bool visit(Widget::Handle self, Widget::Visitor& visitor) override { return visitor(self); }
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override { return visitor(self); }
 
-  inline void setColor(Vec4 color) { mColor = color; }
+  inline void setColor(Vec4 color) { mColor = color; markDirty(); }
   inline Vec4 getColor() const { return mColor; }
-  inline void setBackground(Vec4 color) { mBackground = color; }
+  inline void setBackground(Vec4 color) { mBackground = color; markDirty(); }
   inline Vec4 getBackground() const { return mBackground; }
-  inline void setBorderColor(Vec4 color) { mBorderColor = color; }
+  inline void setBorderColor(Vec4 color) { mBorderColor = color; markDirty(); }
   inline Vec4 getBorderColor() const { return mBorderColor; }
-  inline void setMargin(Vec4 color) { mMargin = color; }
+  inline void setMargin(Vec4 color) { mMargin = color; markDirty(); }
   inline Vec4 getMargin() const { return mMargin; }
-  inline void setWidth(float size) { mWidth = size; }
+  inline void setWidth(float size) { mWidth = size; markDirty(); }
   inline float getWidth() const { return mWidth; }
-  inline void setHeight(float size) { mHeight = size; }
+  inline void setHeight(float size) { mHeight = size; markDirty(); }
   inline float getHeight() const { return mHeight; }
   void setOnChange(OnChangeCallback onChange) { mOnChange = std::move(onChange); }
 
@@ -5,7 +5,7 @@
 namespace Gui {
 
 Column::Handle Column::create(Vec2 size) {
-  auto result = std::make_shared<Column>(size);
+  auto result = makeWidget<Column>(size);
   result->setAlignment(Alignment::Center);
   return result;
 }
@@ -146,6 +146,10 @@ Column::Handle Column::deserialize(const YAML::Node& node, std::vector<Deseriali
     return nullptr;
   }
 
+  // Create the container before its children, so trees built in a WidgetArena
+  // are laid out in depth-first (pre-order) order.
+  auto result = Column::create();
+
   auto id = deserializeId(node["id"], errors);
   auto children = deserializeChildren(node["children"], errors);
   auto color = deserializeColor(node["color"], errors);
@@ -194,10 +198,11 @@ Column::Handle Column::deserialize(const YAML::Node& node, std::vector<Deseriali
     display = node["display"].as<bool>();
   }
 
-  auto result = Column::create();
   result->setId(id);
   result->setAlignment(Alignment::Center);
-  result->mChildren = children;
+  for (auto& child : children) {
+    result->addChild(std::move(child));
+  }
   result->setColor(color);
   result->setPadding(Vec4{padding});
   result->setWidth(width);
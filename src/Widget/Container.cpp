@@ -6,12 +6,28 @@
 namespace Gui {
 
 Container::Handle Container::create(Vec2 size) {
-  return std::make_shared<Container>(size);
+  return makeWidget<Container>(size);
+}
+
+Container::~Container() {
+  // The children may outlive the container.
+  for (auto& child : mChildren) {
+    detach(*child);
+  }
+}
+
+void Container::clearChildren() {
+  for (auto& child : mChildren) {
+    detach(*child);
+  }
+  mChildren.clear();
+  markDirty();
 }
 
 void Container::addChild(Widget::Handle child) {
   child->parent = this;
   mChildren.push_back(std::move(child));
+  markDirty();
 }
 
 Vec2 Container::layout(Constraints constraints) {
@@ -155,11 +171,11 @@ void Container::reportSize() const {
 
 void Container::draw(Renderer2D& renderer) {
   renderer.drawQuad(mPosition, mSize, mColor);
-  for (auto child : mChildren) {
+  for (auto& child : mChildren) {
     if (!child->mDisplay) {
       continue;
     }
-    child->draw(renderer);
+    child->render(renderer);
   }
 }
 
@@ -169,6 +185,10 @@ Container::Handle Container::deserialize(const YAML::Node& node, std::vector<Des
     return nullptr;
   }
 
+  // Create the container before its children, so trees built in a WidgetArena
+  // are laid out in depth-first (pre-order) order.
+  auto result = Container::create();
+
   auto id = deserializeId(node["id"], errors);
   auto children = deserializeChildren(node["children"], errors);
   auto color = deserializeColor(node["color"], errors);
@@ -217,10 +237,11 @@ Container::Handle Container::deserialize(const YAML::Node& node, std::vector<Des
     display = node["display"].as<bool>();
   }
 
-  auto result = Container::create();
   result->setId(id);
   result->setAlignment(Alignment::Center);
-  result->mChildren = children;
+  for (auto& child : children) {
+    result->addChild(std::move(child));
+  }
   result->setColor(color);
   result->setPadding(Vec4{padding});
   result->setWidth(width);
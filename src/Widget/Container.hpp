@@ -30,26 +30,28 @@ public:
 
 public:
   static Container::Handle create(Vec2 size = {0.0f, 0.0f});
+  ~Container() override;
 
   void addChild(Widget::Handle child);
-  void setColor(Vec4 color) { mColor = color; }
-  void clearChildren() { mChildren.clear(); }
-  void setPadding(Vec4 padding) { mPadding = padding; }
-  void setAlignment(Alignment alignment) { mAlignment = alignment; }
-  inline void setWidth(float size) { mWidth = size; }
+  void setColor(Vec4 color) { mColor = color; markDirty(); }
+  void clearChildren();
+  void setPadding(Vec4 padding) { mPadding = padding; markDirty(); }
+  void setAlignment(Alignment alignment) { mAlignment = alignment; markDirty(); }
+  inline void setWidth(float size) { mWidth = size; markDirty(); }
   inline float getWidth() const { return mWidth; }
-  inline void setHeight(float size) { mHeight = size; }
+  inline void setHeight(float size) { mHeight = size; markDirty(); }
   inline float getHeight() const { return mHeight; }
-  inline void setMainAxis(MainAxis value) { mMainAxis = value; }
+  inline void setMainAxis(MainAxis value) { mMainAxis = value; markDirty(); }
   inline MainAxis getMainAxis() const { return mMainAxis; }
-  inline void setCrossAxis(CrossAxis value) { mCrossAxis = value; }
+  inline void setCrossAxis(CrossAxis value) { mCrossAxis = value; markDirty(); }
   inline CrossAxis getCrossAxis() const { return mCrossAxis; }
 
   Vec2 layout(Constraints constraints) override;
   void reportSize() const override;
   void draw(Renderer2D& renderer) override;
-  bool visit(Widget::Handle self, Widget::Visitor& visitor) override {
-    for (auto child : mChildren) {
+  Slice<const Widget::Handle> getChildren() const override { return {mChildren.data(), mChildren.size()}; }
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override {
+    for (auto& child : mChildren) {
       if (!child->visit(child, visitor)) {
         return false;
       }
@@ -5,11 +5,13 @@
 namespace Gui {
 
 Input::Handle Input::create(OnChangeCallback callback, std::string text, float fontSize) {
-  auto target = std::make_shared<Input>(std::move(callback), std::move(text), fontSize);
+  auto target = makeWidget<Input>(std::move(callback), std::move(text), fontSize);
   target->mFocusable = true;
   target->mFixedHeightSizeWidget = true;
-  target->addKeyEventHandler([=](auto event){
-    if (!target->mFocused) {
+  // The widget owns the handler, capturing a shared_ptr would keep it alive forever.
+  auto self = target.get();
+  target->addKeyEventHandler([self](auto event){
+    if (!self->mFocused) {
       return false;
     }
 
@@ -18,9 +20,9 @@ Input::Handle Input::create(OnChangeCallback callback, std::string text, float f
     }
 
     if (event.key == Key::Backspace) {
-      if (!target->mText.empty()) {
-        target->mText.pop_back();
-        target->mOnChange(target->mText);
+      if (!self->mText.empty()) {
+        self->mText.pop_back();
+        self->mOnChange(self->mText);
       }
       return true;
     }
@@ -30,7 +32,7 @@ Input::Handle Input::create(OnChangeCallback callback, std::string text, float f
       return false;
     }
 
-    switch (target->mType) {
+    switch (self->mType) {
       case Type::None: break;
       case Type::Alpha:
         if (!isalpha(ch)) {
@@ -44,8 +46,8 @@ Input::Handle Input::create(OnChangeCallback callback, std::string text, float f
         break;
     }
 
-    target->mText.push_back(ch);
-    target->mOnChange(target->mText);
+    self->mText.push_back(ch);
+    self->mOnChange(self->mText);
     return true;
   });
   return target;
@@ -58,12 +60,11 @@ Vec2 Input::layout(Constraints constraints) {
 }
 
 void Input::draw(Renderer2D& renderer) {
-  renderer.drawQuad(
-    mPosition,
-    mSize,
-    mFocused ? rgba(0xAA2222FF) : rgba(0x222222FF),
-    Effect::Type::Rounded
-  );
+  RectStyle style;
+  style.radii       = Vec4{12.0f};
+  style.borderWidth = 3.0f;
+  style.borderColor = mFocused ? rgba(0xAA2222FF) : rgba(0x222222FF);
+  renderer.drawRect(mPosition, mSize, style);
   if (!mText.empty()) {
     renderer.drawText(mText, mPosition + mFontSize/2.0f, mFontSize, mColor);
   } else {
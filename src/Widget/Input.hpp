@@ -24,23 +24,23 @@ public:
 
   Vec2 layout(Constraints constraints) override;
   void draw(Renderer2D& renderer) override;
-  bool visit(Widget::Handle self, Widget::Visitor& visitor) override { return visitor(self); }
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override { return visitor(self); }
 
-  void setFontSize(float size) { mFontSize = size; }
+  void setFontSize(float size) { mFontSize = size; markDirty(); }
 
   static Input::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors);
 
   const std::string& getText() const { return mText; }
-  void setText(std::string value) { mText = std::move(value); }
+  void setText(std::string value) { mText = std::move(value); markDirty(); }
   Type getType() const { return mType; }
-  void setType(Type value) { mType = value; }
+  void setType(Type value) { mType = value; markDirty(); }
 
   void setOnChange(OnChangeCallback onChange) { mOnChange = std::move(onChange); }
 
-  void setHint(std::string value) { mHint = value; }
+  void setHint(std::string value) { mHint = value; markDirty(); }
   const std::string& getHint() const { return mHint; }
 
-  void setColor(Vec4 value) { mColor = value; }
+  void setColor(Vec4 value) { mColor = value; markDirty(); }
   Vec4 getColor() const { return mColor; }
 
 public: // Do NOT use these function use the create functions!
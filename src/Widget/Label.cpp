@@ -33,10 +33,11 @@ void Label::setText(std::string text) {
   auto[lines, maxColumn] = count(mText);
   mLines = lines;
   mMaxColumn = maxColumn;
+  markDirty();
 }
 
 Label::Handle Label::create(std::string text, float fontSize) {
-  auto result = std::make_shared<Label>(std::move(text), fontSize);
+  auto result = makeWidget<Label>(std::move(text), fontSize);
 
   auto[lines, maxColumn] = count(result->mText);
   result->mLines = lines;
@@ -15,14 +15,14 @@ public:
 
   Vec2 layout(Constraints constraints) override;
   void draw(Renderer2D& renderer) override;
-  bool visit(Widget::Handle self, Widget::Visitor& visitor) override { return visitor(self); }
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override { return visitor(self); }
 
   const std::string& getText() const { return mText; }
   void setText(std::string text);
-  void setFontSize(float size) { mFontSize = size; }
-  void setColor(Vec4 value) { mColor = value; }
+  void setFontSize(float size) { mFontSize = size; markDirty(); }
+  void setColor(Vec4 value) { mColor = value; markDirty(); }
   Vec4 getColor() const { return mColor; }
-  void setMargin(Vec4 value) { mMargin = value; }
+  void setMargin(Vec4 value) { mMargin = value; markDirty(); }
   Vec4 getMargin() const { return mMargin; }
 
   static Label::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors);
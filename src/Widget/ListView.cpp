@@ -0,0 +1,227 @@
+#include "Widget/ListView.hpp"
+#include <Core/Color.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace Gui {
+
+ListView::Handle ListView::create(usize count, ItemBuilder builder, f32 itemHeight) {
+  auto result = makeWidget<ListView>(count, std::move(builder), itemHeight);
+  auto self = result.get();
+  result->addScrollEventHandler([self](auto event) {
+    const f64 before = self->mScrollOffset;
+    self->scrollBy(-event.offset.y * SCROLL_STEP);
+    return self->mScrollOffset == before;
+  });
+  return result;
+}
+
+ListView::~ListView() {
+  // The builder may hand the rows out elsewhere.
+  for (auto& item : mItems) {
+    detach(*item);
+  }
+  for (auto& item : mRecycled) {
+    detach(*item);
+  }
+}
+
+void ListView::setBuilder(ItemBuilder builder) {
+  mBuilder = std::move(builder);
+  invalidate();
+}
+
+void ListView::setItemCount(usize count) {
+  mCount = count;
+  if (mVariableHeights) {
+    mHeights.assign(count, mItemHeight);
+  }
+  invalidate();
+}
+
+void ListView::setItemHeight(f32 height) {
+  mItemHeight = height;
+  mVariableHeights = false;
+  mHeights = {};
+  invalidate();
+}
+
+void ListView::setEstimatedItemHeight(f32 estimate) {
+  mItemHeight = estimate;
+  mVariableHeights = true;
+  mHeights.assign(mCount, estimate);
+  invalidate();
+}
+
+void ListView::invalidate() {
+  recycleAll();
+  markDirty();
+}
+
+void ListView::recycleAll() {
+  for (auto& item : mItems) {
+    mRecycled.push_back(std::move(item));
+  }
+  mItems.clear();
+}
+
+void ListView::setScrollOffset(f64 offset) {
+  const f64 maxOffset = std::max(0.0, getContentHeight() - (f64)mSize.y);
+  offset = std::clamp(offset, 0.0, maxOffset);
+  if (offset != mScrollOffset) {
+    mScrollOffset = offset;
+    markDirty();
+  }
+}
+
+void ListView::scrollBy(f64 delta) {
+  setScrollOffset(mScrollOffset + delta);
+}
+
+void ListView::scrollToIndex(usize index) {
+  setScrollOffset(getOffsetOf(std::min(index, mCount)));
+}
+
+f64 ListView::getContentHeight() const {
+  return mVariableHeights ? mHeights.getTotal() : (f64)mItemHeight * (f64)mCount;
+}
+
+f64 ListView::getOffsetOf(usize index) const {
+  return mVariableHeights ? mHeights.offsetOf(index) : (f64)mItemHeight * (f64)index;
+}
+
+usize ListView::getIndexAt(f64 offset) const {
+  if (mCount == 0) {
+    return 0;
+  }
+  if (mVariableHeights) {
+    return mHeights.indexAt(offset);
+  }
+  return std::min((usize)std::max(0.0, offset / mItemHeight), mCount - 1);
+}
+
+Vec2 ListView::layout(Constraints constraints) {
+  mFixedWidthSizeWidget = !std::isinf(mWidth);
+  mFixedHeightSizeWidget = !std::isinf(mHeight);
+  mSize.x = mFixedWidthSizeWidget  ? mWidth  : constraints.maxWidth;
+  mSize.y = mFixedHeightSizeWidget ? mHeight : constraints.maxHeight;
+
+  // The content may have shrunk since the offset was set.
+  setScrollOffset(mScrollOffset);
+
+  if (mCount == 0 || !mBuilder) {
+    recycleAll();
+    return mSize;
+  }
+
+  const usize firstVisible = getIndexAt(mScrollOffset);
+  const usize first = firstVisible > mOverscan ? firstVisible - mOverscan : 0;
+
+  mNextItems.clear();
+  f64 y = getOffsetOf(first);
+  usize below = 0;
+  for (usize index = first; index < mCount && below <= mOverscan; ++index) {
+    Widget::Handle item;
+    if (index >= mFirst && index < mFirst + mItems.size()) {
+      item = std::move(mItems[index - mFirst]);
+    }
+    if (!item) {
+      Widget::Handle recycled;
+      if (!mRecycled.empty()) {
+        recycled = std::move(mRecycled.back());
+        mRecycled.pop_back();
+      }
+      item = mBuilder(index, std::move(recycled));
+      item->parent = this;
+    }
+
+    item->setPosition({mPosition.x, mPosition.y + (f32)(y - mScrollOffset)});
+    const auto itemSize = item->layout(Constraints(0.0f, 0.0f, mSize.x, mVariableHeights ? mSize.y : mItemHeight));
+
+    f64 height = mItemHeight;
+    if (mVariableHeights) {
+      height = itemSize.y;
+
+      // Rows above the view changing height must not move the rows in view.
+      if (index < firstVisible) {
+        mScrollOffset += height - mHeights.get(index);
+      }
+      mHeights.set(index, height);
+    }
+
+    y += height;
+    if (y > mScrollOffset + mSize.y) {
+      below++;
+    }
+    mNextItems.push_back(std::move(item));
+  }
+
+  for (auto& item : mItems) {
+    if (item) {
+      mRecycled.push_back(std::move(item));
+    }
+  }
+  std::swap(mItems, mNextItems);
+  mFirst = first;
+  return mSize;
+}
+
+void ListView::draw(Renderer2D& renderer) {
+  renderer.pushClip(mPosition, mSize);
+  if (mBackground.a > 0.0f) {
+    renderer.drawQuad(mPosition, mSize, mBackground);
+  }
+  for (auto& item : mItems) {
+    if (item->getDisplay()) {
+      item->render(renderer);
+    }
+  }
+  renderer.popClip();
+}
+
+ListView::Handle ListView::deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors) {
+  auto id = deserializeId(node["id"], errors);
+
+  auto background = Vec4{1.0f, 1.0f, 1.0f, 0.0f};
+  if (node["background"]) {
+    background = deserializeColor(node["background"], errors);
+  }
+
+  float width = INFINITY;
+  if (node.IsMap() && node["width"] && node["width"].IsScalar()) {
+    width = node["width"].as<float>();
+  }
+
+  float height = INFINITY;
+  if (node.IsMap() && node["height"] && node["height"].IsScalar()) {
+    height = node["height"].as<float>();
+  }
+
+  usize overscan = DEFAULT_OVERSCAN;
+  if (node.IsMap() && node["overscan"] && node["overscan"].IsScalar()) {
+    overscan = node["overscan"].as<usize>();
+  }
+
+  bool display = true;
+  if (node.IsMap() && node["display"] && node["display"].IsScalar()) {
+    display = node["display"].as<bool>();
+  }
+
+  // The rows come from code, see setBuilder() and setItemCount().
+  auto result = ListView::create(0, nullptr);
+  result->setId(id);
+  result->setBackground(background);
+  result->setWidth(width);
+  result->setHeight(height);
+  result->setOverscan(overscan);
+  result->setDisplay(display);
+
+  if (node.IsMap() && node["item-height"] && node["item-height"].IsScalar()) {
+    result->setItemHeight(node["item-height"].as<float>());
+  } else if (node.IsMap() && node["estimated-item-height"] && node["estimated-item-height"].IsScalar()) {
+    result->setEstimatedItemHeight(node["estimated-item-height"].as<float>());
+  }
+  return result;
+}
+
+} // namespace Gui
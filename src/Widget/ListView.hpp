@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Core/PrefixSum.hpp"
+#include "Widget/Widget.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace Gui {
+
+// Vertical list of `count` rows, of which only the visible ones (plus a few
+// overscan rows on either side) have widgets. Rows scrolling out of view hand
+// their widget back, and the builder rebinds it to the rows scrolling in.
+//
+// Rows either all have the same height, or their height is estimated until
+// they are first laid out and measured. Offsets are kept in a PrefixSum, so
+// scrolling to any offset or row is O(log n) either way.
+class ListView : public Widget {
+public:
+  using Handle = std::shared_ptr<ListView>;
+
+  // Returns the widget of row `index`. `recycled` is the widget of a row that
+  // went out of view, or null. Update and return it to reuse it.
+  using ItemBuilder = std::function<Widget::Handle(usize index, Widget::Handle recycled)>;
+
+  static constexpr const usize DEFAULT_OVERSCAN = 4;
+
+public:
+  static ListView::Handle create(usize count, ItemBuilder builder, f32 itemHeight = 32.0f);
+  ~ListView() override;
+
+  Vec2 layout(Constraints constraints) override;
+  void draw(Renderer2D& renderer) override;
+  Slice<const Widget::Handle> getChildren() const override { return {mItems.data(), mItems.size()}; }
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override {
+    for (auto& item : mItems) {
+      if (!item->visit(item, visitor)) {
+        return false;
+      }
+    }
+    return visitor(self);
+  }
+  bool clipsChildren() const override { return true; }
+
+  void setBuilder(ItemBuilder builder);
+  void setItemCount(usize count);
+  inline usize getItemCount() const { return mCount; }
+
+  // Every row is `height` tall.
+  void setItemHeight(f32 height);
+
+  // Rows are measured when they are laid out, until then they are assumed to be `estimate` tall.
+  void setEstimatedItemHeight(f32 estimate);
+
+  // Rebuilds the widgets of the rows in view, e.g. after the data changed.
+  void invalidate();
+
+  // Offsets are f64, a million rows are already past where f32 counts whole pixels.
+  void setScrollOffset(f64 offset);
+  inline f64 getScrollOffset() const { return mScrollOffset; }
+  void scrollBy(f64 delta);
+  void scrollToIndex(usize index);
+  f64 getContentHeight() const;
+
+  // Top of row `index` and the row at `offset`, relative to the top of the content.
+  f64 getOffsetOf(usize index) const;
+  usize getIndexAt(f64 offset) const;
+
+  inline void setOverscan(usize rows) { mOverscan = rows; }
+  inline usize getOverscan() const { return mOverscan; }
+  inline void setBackground(Vec4 color) { mBackground = color; markDirty(); }
+  inline Vec4 getBackground() const { return mBackground; }
+  inline void setWidth(float size) { mWidth = size; markDirty(); }
+  inline float getWidth() const { return mWidth; }
+  inline void setHeight(float size) { mHeight = size; markDirty(); }
+  inline float getHeight() const { return mHeight; }
+
+  static ListView::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors);
+
+public: // Do NOT use these function use the create functions!
+  ListView(usize count, ItemBuilder builder, f32 itemHeight)
+    : mCount{count}, mBuilder{std::move(builder)}, mItemHeight{itemHeight}
+  {}
+
+private:
+  void recycleAll();
+
+private:
+  usize mCount;
+  ItemBuilder mBuilder;
+
+  f32 mItemHeight;
+  bool mVariableHeights = false;
+  PrefixSum mHeights;
+
+  f64 mScrollOffset = 0.0;
+  usize mOverscan = DEFAULT_OVERSCAN;
+
+  // Widgets of the rows [mFirst, mFirst + mItems.size()).
+  usize mFirst = 0;
+  std::vector<Widget::Handle> mItems;
+  std::vector<Widget::Handle> mRecycled;
+
+  // Reused by layout().
+  std::vector<Widget::Handle> mNextItems;
+
+  Vec4 mBackground{1.0f, 1.0f, 1.0f, 0.0f};
+  float mWidth{INFINITY};
+  float mHeight{INFINITY};
+};
+
+} // namespace Gui
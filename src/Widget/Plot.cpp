@@ -0,0 +1,329 @@
+#include "Widget/Plot.hpp"
+#include <Core/Color.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Gui {
+
+namespace {
+  constexpr const f32 INFINITY_F32 = std::numeric_limits<f32>::infinity();
+
+  usize roundUpToPowerOfTwo(usize value) {
+    usize result = 2;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+}
+
+Plot::Series::Series(usize capacity, Vec4 color)
+  : mCapacity{roundUpToPowerOfTwo(capacity)}, mColor{color}
+{
+  mSamples.resize(mCapacity);
+  for (usize buckets = mCapacity / 2; buckets != 0; buckets /= 2) {
+    mLevels.emplace_back(buckets);
+  }
+}
+
+void Plot::Series::push(f32 value) {
+  mSamples[mCount & (mCapacity - 1)] = value;
+
+  for (u32 level = 0; level < mLevels.size(); ++level) {
+    const u32 shift = level + 1;
+    auto& buckets = mLevels[level];
+    auto& bucket = buckets[(mCount >> shift) & (buckets.size() - 1)];
+
+    if ((mCount & ((u64(1) << shift) - 1)) == 0) {
+      bucket = {value, value};
+      continue;
+    }
+
+    // The buckets above contain this one, so they wouldn't change either.
+    if (value >= bucket.min && value <= bucket.max) {
+      break;
+    }
+    bucket.min = std::min(bucket.min, value);
+    bucket.max = std::max(bucket.max, value);
+  }
+
+  mCount++;
+  if (mOwner) {
+    mOwner->changed();
+  }
+}
+
+void Plot::Series::push(Slice<const f32> values) {
+  for (usize i = 0; i < values.size(); ++i) {
+    push(values.data()[i]);
+  }
+}
+
+void Plot::Series::clear() {
+  mCount = 0;
+  if (mOwner) {
+    mOwner->changed();
+  }
+}
+
+Plot::Series::Range Plot::Series::range(u64 first, u64 last, u32 level) const {
+  Range result = {INFINITY_F32, -INFINITY_F32};
+  if (level == 0) {
+    for (u64 i = first; i < last; ++i) {
+      const f32 value = mSamples[i & (mCapacity - 1)];
+      result.min = std::min(result.min, value);
+      result.max = std::max(result.max, value);
+    }
+    return result;
+  }
+
+  // The oldest bucket shares its slot with the newest one once it is partially
+  // overwritten, read what is left of it from the samples.
+  u64 bucket = first >> level;
+  if ((bucket << level) < getBegin()) {
+    const u64 boundary = std::min((bucket + 1) << level, last);
+    result = range(first, boundary, 0);
+    if (boundary == last) {
+      return result;
+    }
+    bucket++;
+  }
+
+  const auto& buckets = mLevels[level - 1];
+  for (u64 i = bucket; i <= (last - 1) >> level; ++i) {
+    const auto& bucket = buckets[i & (buckets.size() - 1)];
+    result.min = std::min(result.min, bucket.min);
+    result.max = std::max(result.max, bucket.max);
+  }
+  return result;
+}
+
+void Plot::Series::decimate(f64 from, f64 to, u32 columns, std::vector<Column>& out) const {
+  out.clear();
+
+  const f64 begin = std::max(from, (f64)getBegin());
+  const f64 end   = std::min(to,   (f64)getEnd());
+  if (end <= begin || columns == 0) {
+    return;
+  }
+
+  const f64 perColumn = (to - from) / columns;
+  if (perColumn < 2.0) {
+    for (u64 i = (u64)std::ceil(begin); i < (u64)std::ceil(end); ++i) {
+      const f32 value = mSamples[i & (mCapacity - 1)];
+      out.push_back({(f64)i, {value, value}});
+    }
+    return;
+  }
+
+  // Between one and two buckets per column, three when they straddle a column edge.
+  const u32 level = std::min((u32)std::log2(perColumn), (u32)mLevels.size());
+  for (u32 column = 0; column < columns; ++column) {
+    const f64 x = from + column * perColumn;
+    const u64 first = (u64)std::max(x, begin);
+    const u64 last  = (u64)std::ceil(std::min(x + perColumn, end));
+    if (last <= first) {
+      continue;
+    }
+    out.push_back({x, range(first, last, level)});
+  }
+}
+
+Plot::Handle Plot::create(f32 width, f32 height) {
+  return makeWidget<Plot>(width, height);
+}
+
+Plot::Series& Plot::addSeries(Vec4 color, usize capacity) {
+  mSeries.push_back(std::make_unique<Series>(capacity, color));
+  mSeries.back()->mOwner = this;
+  markDirty();
+  return *mSeries.back();
+}
+
+void Plot::follow(u64 window) {
+  mFollow = window;
+  markDirty();
+}
+
+void Plot::setView(f64 from, f64 to) {
+  mFollow = 0;
+  mFrom = from;
+  mTo = std::max(to, from + 1.0);
+  markDirty();
+}
+
+void Plot::zoom(f64 factor, f64 anchor) {
+  updateView();
+  const f64 pivot = mFrom + (mTo - mFrom) * anchor;
+  setView(pivot - (pivot - mFrom) / factor, pivot + (mTo - pivot) / factor);
+}
+
+void Plot::pan(f64 samples) {
+  updateView();
+  setView(mFrom + samples, mTo + samples);
+}
+
+void Plot::setRange(f32 min, f32 max) {
+  mAutoRange = false;
+  mMin = min;
+  mMax = max;
+  markDirty();
+}
+
+void Plot::autoRange() {
+  mAutoRange = true;
+  markDirty();
+}
+
+void Plot::updateView() {
+  if (mFollow == 0) {
+    return;
+  }
+
+  u64 end = 0;
+  for (const auto& series : mSeries) {
+    end = std::max(end, series->getEnd());
+  }
+  mTo = (f64)end;
+  mFrom = mTo - (f64)mFollow;
+}
+
+Vec2 Plot::layout(Constraints) {
+  mFixedWidthSizeWidget = !std::isinf(mWidth);
+  mFixedHeightSizeWidget = !std::isinf(mHeight);
+  mSize.x = mWidth;
+  mSize.y = mHeight;
+  return mSize;
+}
+
+void Plot::draw(Renderer2D& renderer) {
+  mChanged = false;
+  renderer.drawQuad(mPosition, mSize, mBackground);
+
+  updateView();
+  if (mTo <= mFrom) {
+    return;
+  }
+
+  const u32 columns = std::max(1u, (u32)mSize.x);
+  mColumns.resize(mSeries.size());
+
+  f32 min = mMin;
+  f32 max = mMax;
+  if (mAutoRange) {
+    min = INFINITY_F32;
+    max = -INFINITY_F32;
+  }
+  for (usize i = 0; i < mSeries.size(); ++i) {
+    mSeries[i]->decimate(mFrom, mTo, columns, mColumns[i]);
+    if (mAutoRange) {
+      for (const auto& column : mColumns[i]) {
+        min = std::min(min, column.range.min);
+        max = std::max(max, column.range.max);
+      }
+    }
+  }
+  if (!(min <= max)) {
+    min = 0.0f;
+    max = 1.0f;
+  } else if (min == max) {
+    min -= 0.5f;
+    max += 0.5f;
+  }
+
+  const f64 scaleX = mSize.x / (mTo - mFrom);
+  const f32 scaleY = mSize.y / (max - min);
+  const f32 bottom = mPosition.y + mSize.y;
+  for (usize i = 0; i < mSeries.size(); ++i) {
+    mPoints.clear();
+    const auto& series = mColumns[i];
+    for (usize j = 0; j < series.size(); ++j) {
+      const auto& column = series[j];
+      const f32 x    = mPosition.x + (f32)((column.x - mFrom) * scaleX);
+      const f32 low  = bottom - (std::clamp(column.range.min, min, max) - min) * scaleY;
+      const f32 high = bottom - (std::clamp(column.range.max, min, max) - min) * scaleY;
+
+      // One vertex pair per column, alternating so consecutive columns join end to end.
+      if (low == high) {
+        mPoints.push_back({x, low});
+      } else if (j % 2 == 0) {
+        mPoints.push_back({x, low});
+        mPoints.push_back({x, high});
+      } else {
+        mPoints.push_back({x, high});
+        mPoints.push_back({x, low});
+      }
+    }
+    renderer.drawPolyline({mPoints.data(), mPoints.size()}, mLineWidth, mSeries[i]->getColor());
+  }
+}
+
+Plot::Handle Plot::deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors) {
+  auto id = deserializeId(node["id"], errors);
+
+  auto background = Color::BLACK;
+  if (node["background"]) {
+    background = deserializeColor(node["background"], errors);
+  }
+
+  float width = 400.0f;
+  if (node.IsMap() && node["width"] && node["width"].IsScalar()) {
+    width = node["width"].as<float>();
+  }
+
+  float height = 200.0f;
+  if (node.IsMap() && node["height"] && node["height"].IsScalar()) {
+    height = node["height"].as<float>();
+  }
+
+  float lineWidth = 1.5f;
+  if (node.IsMap() && node["line-width"] && node["line-width"].IsScalar()) {
+    lineWidth = node["line-width"].as<float>();
+  }
+
+  u64 window = 0;
+  if (node.IsMap() && node["window"] && node["window"].IsScalar()) {
+    window = node["window"].as<u64>();
+  }
+
+  bool display = true;
+  if (node.IsMap() && node["display"] && node["display"].IsScalar()) {
+    display = node["display"].as<bool>();
+  }
+
+  auto result = Plot::create(width, height);
+  result->setId(id);
+  result->setBackground(background);
+  result->setLineWidth(lineWidth);
+  result->follow(window);
+  result->setDisplay(display);
+
+  if (node.IsMap() && node["min"] && node["min"].IsScalar() && node["max"] && node["max"].IsScalar()) {
+    result->setRange(node["min"].as<float>(), node["max"].as<float>());
+  }
+
+  if (node.IsMap() && node["series"]) {
+    const auto& series = node["series"];
+    if (!series.IsSequence()) {
+      insertDeserializationError(errors, series.Mark(), "Expected series field to be a sequence!");
+      return result;
+    }
+
+    for (const auto& entry : series) {
+      auto color = Color::GREEN;
+      if (entry.IsMap() && entry["color"]) {
+        color = deserializeColor(entry["color"], errors);
+      }
+
+      usize capacity = DEFAULT_CAPACITY;
+      if (entry.IsMap() && entry["capacity"] && entry["capacity"].IsScalar()) {
+        capacity = entry["capacity"].as<usize>();
+      }
+      result->addSeries(color, capacity);
+    }
+  }
+  return result;
+}
+
+} // namespace Gui
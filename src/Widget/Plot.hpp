@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Widget/Widget.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace Gui {
+
+// Line plot of one or more series of evenly spaced samples, e.g. telemetry.
+//
+// Each series keeps its latest samples in a ring buffer, plus a pyramid of the
+// minimum and maximum of every 2, 4, 8, ... samples that is updated as samples
+// arrive. Drawing picks the level with about one bucket per pixel of the
+// current view, so a frame costs the same whether the view covers a thousand
+// samples or millions of them, and panning or zooming never reads the raw
+// samples again.
+class Plot : public Widget {
+public:
+  using Handle = std::shared_ptr<Plot>;
+
+  static constexpr const usize DEFAULT_CAPACITY = 1 << 20;
+
+  class Series {
+  public:
+    struct Range {
+      f32 min;
+      f32 max;
+    };
+
+    // Samples at `x`, the index of the first sample in it.
+    struct Column {
+      f64   x;
+      Range range;
+    };
+
+  public:
+    // The capacity is rounded up to a power of two.
+    Series(usize capacity, Vec4 color);
+
+    // O(log capacity) at worst, a level is only touched while its bucket
+    // changes. Noisy samples stop after a level or two, a monotonic series
+    // sets a new extreme every time and walks all of them.
+    void push(f32 value);
+    void push(Slice<const f32> values);
+    void clear();
+
+    // Indices of the first and one past the last sample still held.
+    inline u64 getBegin() const { return mCount > mCapacity ? mCount - mCapacity : 0; }
+    inline u64 getEnd() const { return mCount; }
+    inline usize getCapacity() const { return mCapacity; }
+
+    inline Vec4 getColor() const { return mColor; }
+    inline void setColor(Vec4 color) { mColor = color; if (mOwner) mOwner->markDirty(); }
+
+    // Minimum and maximum of the samples in [from, to) split into `columns`
+    // columns. When there are fewer samples than columns every sample is its
+    // own column.
+    void decimate(f64 from, f64 to, u32 columns, std::vector<Column>& out) const;
+
+  private:
+    Range range(u64 first, u64 last, u32 level) const;
+
+  private:
+    friend class Plot;
+
+    // Marked dirty when samples arrive, if the series belongs to a plot.
+    Plot* mOwner = nullptr;
+
+    usize mCapacity;
+    Vec4 mColor;
+
+    std::vector<f32> mSamples;
+
+    // Level k holds the buckets of 2^(k + 1) samples, capacity >> (k + 1) of them.
+    std::vector<std::vector<Range>> mLevels;
+    u64 mCount = 0;
+  };
+
+public:
+  static Plot::Handle create(f32 width, f32 height);
+
+  Vec2 layout(Constraints constraints) override;
+  void draw(Renderer2D& renderer) override;
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override { return visitor(self); }
+
+  Series& addSeries(Vec4 color, usize capacity = DEFAULT_CAPACITY);
+  inline Series& getSeries(usize index) { return *mSeries[index]; }
+  inline usize getSeriesCount() const { return mSeries.size(); }
+
+  // Shows the latest `window` samples, scrolling as samples arrive. Zero stops
+  // following.
+  void follow(u64 window);
+
+  // Shows the samples in [from, to) and stops following.
+  void setView(f64 from, f64 to);
+  inline f64 getViewBegin() const { return mFrom; }
+  inline f64 getViewEnd() const { return mTo; }
+
+  // Zooms around `anchor`, 0 being the left edge and 1 the right one.
+  void zoom(f64 factor, f64 anchor = 0.5);
+  void pan(f64 samples);
+
+  // Fixed vertical range, otherwise it fits the visible samples.
+  void setRange(f32 min, f32 max);
+  void autoRange();
+
+  inline void setBackground(Vec4 color) { mBackground = color; markDirty(); }
+  inline Vec4 getBackground() const { return mBackground; }
+  inline void setLineWidth(f32 width) { mLineWidth = width; markDirty(); }
+  inline f32 getLineWidth() const { return mLineWidth; }
+  inline void setWidth(float size) { mWidth = size; markDirty(); }
+  inline float getWidth() const { return mWidth; }
+  inline void setHeight(float size) { mHeight = size; markDirty(); }
+  inline float getHeight() const { return mHeight; }
+
+  static Plot::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors);
+
+public: // Do NOT use these function use the create functions!
+  Plot(f32 width, f32 height)
+    : mWidth{width}, mHeight{height}
+  {}
+
+private:
+  void updateView();
+
+  // Marks the plot dirty once per drawn frame however many samples arrive.
+  inline void changed() {
+    if (!mChanged) {
+      mChanged = true;
+      markDirty();
+    }
+  }
+
+private:
+  std::vector<std::unique_ptr<Series>> mSeries;
+  bool mChanged = false;
+
+  f64 mFrom = 0.0;
+  f64 mTo   = 0.0;
+  u64 mFollow = 0;
+
+  bool mAutoRange = true;
+  f32 mMin = 0.0f;
+  f32 mMax = 1.0f;
+
+  Vec4 mBackground = Color::BLACK;
+  f32 mLineWidth = 1.5f;
+  float mWidth;
+  float mHeight;
+
+  // Reused every frame.
+  std::vector<std::vector<Series::Column>> mColumns;
+  std::vector<Vec2> mPoints;
+};
+
+} // namespace Gui
@@ -5,7 +5,7 @@
 namespace Gui {
 
 Row::Handle Row::create(Vec2 size) {
-  return std::make_shared<Row>(size);
+  return makeWidget<Row>(size);
 }
 
 Row::Handle Row::deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors) {
@@ -14,6 +14,10 @@ Row::Handle Row::deserialize(const YAML::Node& node, std::vector<Deserialization
     return nullptr;
   }
 
+  // Create the container before its children, so trees built in a WidgetArena
+  // are laid out in depth-first (pre-order) order.
+  auto result = Row::create();
+
   auto id = deserializeId(node["id"], errors);
   auto children = deserializeChildren(node["children"], errors);
   auto color = deserializeColor(node["color"], errors);
@@ -62,10 +66,11 @@ Row::Handle Row::deserialize(const YAML::Node& node, std::vector<Deserialization
     display = node["display"].as<bool>();
   }
 
-  auto result = Row::create();
   result->setId(id);
   result->setAlignment(Alignment::Center);
-  result->mChildren = children;
+  for (auto& child : children) {
+    result->addChild(std::move(child));
+  }
   result->setColor(color);
   result->setPadding(Vec4{padding});
   result->setWidth(width);
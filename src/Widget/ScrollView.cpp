@@ -0,0 +1,241 @@
+#include "Widget/ScrollView.hpp"
+#include <Core/Color.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace Gui {
+
+namespace {
+  // Below this, in pixels per second, gliding stops.
+  constexpr const f32 MIN_VELOCITY = 1.0f;
+
+  constexpr const f32 SCROLLBAR_WIDTH = 4.0f;
+  constexpr const f32 SCROLLBAR_MIN_LENGTH = 16.0f;
+}
+
+ScrollView::Handle ScrollView::create(Widget::Handle child) {
+  auto result = makeWidget<ScrollView>(nullptr);
+  result->setChild(std::move(child));
+
+  auto self = result.get();
+  result->addScrollEventHandler([self](auto event) {
+    Vec2 delta = -event.offset * SCROLL_STEP;
+    if (!self->mHorizontal) delta.x = 0.0f;
+    if (!self->mVertical)   delta.y = 0.0f;
+
+    // Let the view around this one scroll when there is nowhere to go.
+    const Vec2 target = glm::clamp(self->mScroll + delta, Vec2{0.0f}, self->getMaxScroll());
+    if (target == self->mScroll) {
+      return true;
+    }
+    self->scrollSmoothlyBy(delta);
+    return false;
+  });
+  return result;
+}
+
+ScrollView::~ScrollView() {
+  if (mChild) {
+    detach(*mChild);
+  }
+}
+
+void ScrollView::setChild(Widget::Handle child) {
+  if (mChild) {
+    detach(*mChild);
+  }
+  mChild = std::move(child);
+  if (mChild) {
+    mChild->parent = this;
+  }
+  markDirty();
+}
+
+void ScrollView::setScroll(Vec2 offset) {
+  mVelocity = Vec2{0.0f};
+  offset = glm::clamp(offset, Vec2{0.0f}, getMaxScroll());
+  if (offset != mScroll) {
+    mScroll = offset;
+    markDirty();
+  }
+}
+
+bool ScrollView::scrollBy(Vec2 delta) {
+  const Vec2 before = mScroll;
+  if (mHorizontal) mScroll.x += delta.x;
+  if (mVertical)   mScroll.y += delta.y;
+  mScroll = glm::clamp(mScroll, Vec2{0.0f}, getMaxScroll());
+  if (mScroll == before) {
+    return false;
+  }
+  markDirty();
+  return true;
+}
+
+void ScrollView::scrollSmoothlyBy(Vec2 distance) {
+  // The velocity decays exponentially, so it travels velocity / deceleration in total.
+  fling(mVelocity + distance * mDeceleration);
+}
+
+void ScrollView::fling(Vec2 velocity) {
+  mVelocity = velocity;
+  if (!mHorizontal) mVelocity.x = 0.0f;
+  if (!mVertical)   mVelocity.y = 0.0f;
+}
+
+void ScrollView::animate(f32 dt) {
+  // Integrated exactly, so the distance doesn't depend on the frame rate.
+  const f32 decay = std::exp(-mDeceleration * dt);
+  const Vec2 delta = mVelocity * (1.0f - decay) / mDeceleration;
+  mVelocity *= decay;
+  scrollBy(delta);
+
+  const Vec2 max = getMaxScroll();
+  for (u32 i = 0; i < 2; ++i) {
+    const bool atEdge = (mVelocity[i] < 0.0f && mScroll[i] <= 0.0f) || (mVelocity[i] > 0.0f && mScroll[i] >= max[i]);
+    if (atEdge || std::abs(mVelocity[i]) < MIN_VELOCITY) {
+      mVelocity[i] = 0.0f;
+    }
+  }
+}
+
+Vec2 ScrollView::layout(Constraints constraints) {
+  mFixedWidthSizeWidget = !std::isinf(mWidth);
+  mFixedHeightSizeWidget = !std::isinf(mHeight);
+  mSize.x = mFixedWidthSizeWidget  ? mWidth  : constraints.maxWidth;
+  mSize.y = mFixedHeightSizeWidget ? mHeight : constraints.maxHeight;
+
+  mContentSize = Vec2{0.0f};
+  if (mChild && mChild->getDisplay()) {
+    // Not moved by the scroll offset, that is only applied when drawing.
+    mChild->setPosition(mPosition);
+    Vec2 bound = {mHorizontal ? INFINITY : mSize.x, mVertical ? INFINITY : mSize.y};
+    mContentSize = mChild->layout(Constraints(0.0f, 0.0f, bound.x, bound.y));
+
+    // A child that takes all the space it is given, like the centered rows and
+    // columns of YAML documents, is as large as its children instead.
+    bool measured = false;
+    for (u32 axis = 0; axis < 2; ++axis) {
+      if (std::isinf(mContentSize[axis])) {
+        bound[axis] = measureChildren(axis);
+        measured = true;
+      }
+    }
+    if (measured) {
+      mContentSize = mChild->layout(Constraints(0.0f, 0.0f, bound.x, bound.y));
+    }
+  }
+
+  // The content may have shrunk since the offset was set.
+  mScroll = glm::clamp(mScroll, Vec2{0.0f}, getMaxScroll());
+  return mSize;
+}
+
+f32 ScrollView::measureChildren(u32 axis) const {
+  const f32 start = mChild->mPosition[axis];
+  f32 end = start;
+  for (const auto& child : mChild->getChildren()) {
+    const f32 childEnd = child->mPosition[axis] + child->mSize[axis];
+    if (child->getDisplay() && std::isfinite(childEnd)) {
+      end = std::max(end, childEnd);
+    }
+  }
+
+  // Children placed at infinity, e.g. fixed size ones centered in infinite
+  // space, can't be measured. The child then fits the view.
+  return end > start ? end - start : mSize[axis];
+}
+
+void ScrollView::draw(Renderer2D& renderer) {
+  if (mBackground.a > 0.0f) {
+    renderer.drawQuad(mPosition, mSize, mBackground);
+  }
+  if (!mChild || !mChild->getDisplay()) {
+    return;
+  }
+
+  renderer.pushClip(mPosition, mSize);
+  renderer.pushTranslation(getChildOffset());
+  mChild->render(renderer);
+  renderer.popTransform();
+  renderer.popClip();
+
+  if (mScrollbarColor.a <= 0.0f) {
+    return;
+  }
+
+  const Vec2 max = getMaxScroll();
+  if (max.y > 0.0f) {
+    const f32 length = std::max(SCROLLBAR_MIN_LENGTH, mSize.y * mSize.y / mContentSize.y);
+    const f32 y = mPosition.y + (mSize.y - length) * (mScroll.y / max.y);
+    renderer.drawQuad({mPosition.x + mSize.x - 2.0f * SCROLLBAR_WIDTH, y}, {SCROLLBAR_WIDTH, length}, mScrollbarColor);
+  }
+  if (max.x > 0.0f) {
+    const f32 length = std::max(SCROLLBAR_MIN_LENGTH, mSize.x * mSize.x / mContentSize.x);
+    const f32 x = mPosition.x + (mSize.x - length) * (mScroll.x / max.x);
+    renderer.drawQuad({x, mPosition.y + mSize.y - 2.0f * SCROLLBAR_WIDTH}, {length, SCROLLBAR_WIDTH}, mScrollbarColor);
+  }
+}
+
+ScrollView::Handle ScrollView::deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors) {
+  auto id = deserializeId(node["id"], errors);
+
+  auto background = Vec4{1.0f, 1.0f, 1.0f, 0.0f};
+  if (node["background"]) {
+    background = deserializeColor(node["background"], errors);
+  }
+
+  auto scrollbarColor = Vec4{0.0f, 0.0f, 0.0f, 0.35f};
+  if (node["scrollbar-color"]) {
+    scrollbarColor = deserializeColor(node["scrollbar-color"], errors);
+  }
+
+  float width = INFINITY;
+  if (node.IsMap() && node["width"] && node["width"].IsScalar()) {
+    width = node["width"].as<float>();
+  }
+
+  float height = INFINITY;
+  if (node.IsMap() && node["height"] && node["height"].IsScalar()) {
+    height = node["height"].as<float>();
+  }
+
+  bool horizontal = false;
+  if (node.IsMap() && node["horizontal"] && node["horizontal"].IsScalar()) {
+    horizontal = node["horizontal"].as<bool>();
+  }
+
+  bool vertical = true;
+  if (node.IsMap() && node["vertical"] && node["vertical"].IsScalar()) {
+    vertical = node["vertical"].as<bool>();
+  }
+
+  float deceleration = DEFAULT_DECELERATION;
+  if (node.IsMap() && node["deceleration"] && node["deceleration"].IsScalar()) {
+    deceleration = node["deceleration"].as<float>();
+  }
+
+  bool display = true;
+  if (node.IsMap() && node["display"] && node["display"].IsScalar()) {
+    display = node["display"].as<bool>();
+  }
+
+  Widget::Handle child;
+  if (node.IsMap() && node["child"]) {
+    child = Widget::deserialize(node["child"], errors);
+  }
+
+  auto result = ScrollView::create(std::move(child));
+  result->setId(id);
+  result->setBackground(background);
+  result->setScrollbarColor(scrollbarColor);
+  result->setWidth(width);
+  result->setHeight(height);
+  result->setHorizontal(horizontal);
+  result->setVertical(vertical);
+  result->setDeceleration(deceleration);
+  result->setDisplay(display);
+  return result;
+}
+
+} // namespace Gui
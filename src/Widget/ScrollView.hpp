@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Widget/Widget.hpp"
+
+namespace Gui {
+
+// Shows a part of a child that is larger than itself.
+//
+// The child is laid out once at its full size, independent of the scroll
+// offset, and drawn moved by the offset through the renderer's translation,
+// clipped to the view. Along the scrolling axes the child is given unbounded
+// space. If it fills that, it is laid out again at the extent of its own
+// children, without their trailing padding. Scrolling therefore never lays the child out again, and
+// the containers inside it skip the children that are out of view.
+//
+// The wheel doesn't jump, it gives the content a velocity that decays over a
+// few frames and adds up to the same distance. fling() starts the same motion
+// with any velocity, e.g. at the end of a drag.
+class ScrollView : public Widget {
+public:
+  using Handle = std::shared_ptr<ScrollView>;
+
+  // How fast the velocity decays, per second.
+  static constexpr const f32 DEFAULT_DECELERATION = 12.0f;
+
+public:
+  static ScrollView::Handle create(Widget::Handle child = nullptr);
+  ~ScrollView() override;
+
+  Vec2 layout(Constraints constraints) override;
+  void draw(Renderer2D& renderer) override;
+  Slice<const Widget::Handle> getChildren() const override {
+    return {&mChild, mChild ? 1u : 0u};
+  }
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override {
+    if (mChild && !mChild->visit(mChild, visitor)) {
+      return false;
+    }
+    return visitor(self);
+  }
+
+  Vec2 getChildOffset() const override { return -glm::round(mScroll); }
+  bool clipsChildren() const override { return true; }
+  bool isAnimating() const override { return mVelocity != Vec2{0.0f}; }
+  void animate(f32 dt) override;
+
+  void setChild(Widget::Handle child);
+  inline const Widget::Handle& getChild() const { return mChild; }
+
+  // Which directions scroll. The child is given unbounded space along them.
+  inline void setHorizontal(bool yes) { mHorizontal = yes; markDirty(); }
+  inline bool isHorizontal() const { return mHorizontal; }
+  inline void setVertical(bool yes) { mVertical = yes; markDirty(); }
+  inline bool isVertical() const { return mVertical; }
+
+  // Clamped to the content, stops any motion.
+  void setScroll(Vec2 offset);
+  inline Vec2 getScroll() const { return mScroll; }
+  inline Vec2 getMaxScroll() const { return glm::max(Vec2{0.0f}, mContentSize - mSize); }
+  inline Vec2 getContentSize() const { return mContentSize; }
+
+  // Returns whether the offset changed, that is false at the edges.
+  bool scrollBy(Vec2 delta);
+
+  // Glides by `distance` pixels in total.
+  void scrollSmoothlyBy(Vec2 distance);
+
+  // Starts gliding with the given velocity in pixels per second.
+  void fling(Vec2 velocity);
+  inline Vec2 getVelocity() const { return mVelocity; }
+
+  inline void setDeceleration(f32 rate) { mDeceleration = rate; }
+  inline f32 getDeceleration() const { return mDeceleration; }
+  inline void setBackground(Vec4 color) { mBackground = color; markDirty(); }
+  inline Vec4 getBackground() const { return mBackground; }
+  inline void setScrollbarColor(Vec4 color) { mScrollbarColor = color; markDirty(); }
+  inline Vec4 getScrollbarColor() const { return mScrollbarColor; }
+  inline void setWidth(float size) { mWidth = size; markDirty(); }
+  inline float getWidth() const { return mWidth; }
+  inline void setHeight(float size) { mHeight = size; markDirty(); }
+  inline float getHeight() const { return mHeight; }
+
+  static ScrollView::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors);
+
+public: // Do NOT use these function use the create functions!
+  ScrollView(Widget::Handle child)
+    : mChild{std::move(child)}
+  {}
+
+private:
+  // Extent of the child's children from its start along `axis`.
+  f32 measureChildren(u32 axis) const;
+
+private:
+  Widget::Handle mChild;
+
+  bool mHorizontal = false;
+  bool mVertical = true;
+
+  Vec2 mScroll{0.0f};
+  Vec2 mContentSize{0.0f};
+  Vec2 mVelocity{0.0f};
+  f32 mDeceleration = DEFAULT_DECELERATION;
+
+  Vec4 mBackground{1.0f, 1.0f, 1.0f, 0.0f};
+  Vec4 mScrollbarColor{0.0f, 0.0f, 0.0f, 0.35f};
+  float mWidth{INFINITY};
+  float mHeight{INFINITY};
+};
+
+} // namespace Gui
@@ -4,13 +4,13 @@
 namespace Gui {
 
 SizedBox::Handle SizedBox::create(float width, float height) {
-  auto result = std::make_shared<SizedBox>(width, height);
+  auto result = makeWidget<SizedBox>(width, height);
   result->mFixedWidthSizeWidget = true;
   result->mFixedHeightSizeWidget = true;
   return result;
 }
 SizedBox::Handle SizedBox::create(Vec2 size) {
-  auto result = std::make_shared<SizedBox>(size);
+  auto result = makeWidget<SizedBox>(size);
   result->mFixedWidthSizeWidget = true;
   result->mFixedHeightSizeWidget = true;
   return result;
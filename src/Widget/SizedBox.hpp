@@ -12,11 +12,11 @@ public:
   static SizedBox::Handle create(float width = 0.0, float height = 0.0);
   static SizedBox::Handle create(Vec2 size);
 
-  void setColor(Vec4 color) { mColor = color; }
+  void setColor(Vec4 color) { mColor = color; markDirty(); }
 
   Vec2 layout(Constraints constraints) override;
   void draw(Renderer2D& renderer) override;
-  bool visit(Widget::Handle self, Widget::Visitor& visitor) override { return visitor(self); }
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override { return visitor(self); }
 
   static SizedBox::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors);
 
@@ -0,0 +1,305 @@
+#include "Widget/Table.hpp"
+#include <Core/Color.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace Gui {
+
+namespace {
+  constexpr const f32 CELL_PADDING = 4.0f;
+
+  void columnName(usize column, String& out) {
+    do {
+      out.insert(out.begin(), (char)('A' + column % 26));
+      column = column / 26;
+    } while (column-- != 0);
+  }
+}
+
+Table::Handle Table::create(usize rows, usize columns, CellCallback cell, HeaderCallback header) {
+  auto result = makeWidget<Table>(rows, columns, std::move(cell), std::move(header));
+  auto self = result.get();
+  result->addScrollEventHandler([self](auto event) {
+    const f64 x = self->mScrollX;
+    const f64 y = self->mScrollY;
+    self->scrollBy(-event.offset.x * SCROLL_STEP, -event.offset.y * SCROLL_STEP);
+    return self->mScrollX == x && self->mScrollY == y;
+  });
+  return result;
+}
+
+Table::Table(usize rows, usize columns, CellCallback cell, HeaderCallback header)
+  : mRows{rows}, mCell{std::move(cell)}, mHeader{std::move(header)}
+{
+  mColumns.assign(columns, mDefaultColumnWidth);
+}
+
+void Table::setCellCallback(CellCallback cell) {
+  mCell = std::move(cell);
+  invalidate();
+}
+
+void Table::setHeaderCallback(HeaderCallback header) {
+  mHeader = std::move(header);
+  markDirty();
+}
+
+void Table::setSize(usize rows, usize columns) {
+  mRows = rows;
+  mColumns.assign(columns, mDefaultColumnWidth);
+  invalidate();
+}
+
+void Table::invalidate() {
+  mCells.clear();
+  markDirty();
+}
+
+void Table::invalidateCell(usize row, usize column) {
+  mCells.erase((u64)row * mColumns.size() + column);
+  markDirty();
+}
+
+void Table::setColumnWidth(usize column, f32 width) {
+  mColumns.set(column, std::max(width, 0.0f));
+  markDirty();
+}
+
+void Table::setDefaultColumnWidth(f32 width) {
+  mDefaultColumnWidth = width;
+  mColumns.assign(mColumns.size(), width);
+  markDirty();
+}
+
+void Table::setScroll(f64 x, f64 y) {
+  const f64 frozenWidth = mColumns.offsetOf(std::min(mFrozenColumns, mColumns.size()));
+  const f64 maxX = std::max(0.0, mColumns.getTotal() - std::max((f64)mSize.x, frozenWidth));
+  const f64 maxY = std::max(0.0, (f64)mRowHeight * (f64)mRows - ((f64)mSize.y - mHeaderHeight));
+  x = std::clamp(x, 0.0, maxX);
+  y = std::clamp(y, 0.0, maxY);
+  if (x != mScrollX || y != mScrollY) {
+    mScrollX = x;
+    mScrollY = y;
+    markDirty();
+  }
+}
+
+void Table::scrollBy(f64 x, f64 y) {
+  setScroll(mScrollX + x, mScrollY + y);
+}
+
+void Table::scrollToCell(usize row, usize column) {
+  const usize frozen = std::min(mFrozenColumns, mColumns.size());
+  const f64 x = column > frozen ? mColumns.offsetOf(column) - mColumns.offsetOf(frozen) : mScrollX;
+  setScroll(x, (f64)mRowHeight * (f64)row);
+}
+
+Vec2 Table::layout(Constraints constraints) {
+  mFixedWidthSizeWidget = !std::isinf(mWidth);
+  mFixedHeightSizeWidget = !std::isinf(mHeight);
+  mSize.x = mFixedWidthSizeWidget  ? mWidth  : constraints.maxWidth;
+  mSize.y = mFixedHeightSizeWidget ? mHeight : constraints.maxHeight;
+
+  // The table may have shrunk since the offsets were set.
+  setScroll(mScrollX, mScrollY);
+  return mSize;
+}
+
+Table::Span Table::columnSpan(usize first, usize end, f64 from, f64 to, f32 x) const {
+  Span span = {end, end, x};
+  if (first >= end) {
+    return span;
+  }
+
+  span.first = std::max(first, mColumns.indexAt(from));
+  f64 offset = mColumns.offsetOf(span.first);
+  span.x = x + (f32)(offset - from);
+
+  span.last = span.first;
+  while (span.last < end && offset < to) {
+    offset += mColumns.get(span.last++);
+  }
+  return span;
+}
+
+const Table::Cell& Table::cell(const Renderer2D& renderer, usize row, usize column) {
+  const u64 key = (u64)row * mColumns.size() + column;
+  auto it = mCells.find(key);
+  if (it != mCells.end()) {
+    it->second.frame = mFrame;
+    mStats.cached++;
+    return it->second;
+  }
+
+  mCellText.clear();
+  if (mCell) {
+    mCell(row, column, mCellText);
+  }
+  Cell cell = {{}, mFrame};
+  renderer.layoutText(mCellText, cell.glyphs);
+  mStats.formatted++;
+  return mCells.emplace(key, std::move(cell)).first->second;
+}
+
+void Table::drawText(Renderer2D& renderer, StringView text, f32 x, f32 y, f32 width) {
+  // The font is monospaced, so the text is cut to the column without measuring it.
+  const f32 advance = mFontSize - mFontSize / 7.0f;
+  const usize fits = (usize)std::max(0.0f, (width - CELL_PADDING * 2.0f) / advance);
+  if (fits == 0 || text.empty()) {
+    return;
+  }
+  renderer.drawText(text.substr(0, fits), Vec2{x + CELL_PADDING, y + (mRowHeight - mFontSize) / 2.0f}, mFontSize, mColor);
+}
+
+void Table::drawCells(Renderer2D& renderer, const Span& columns, usize firstRow, usize lastRow, f32 y) {
+  // Monospaced, the glyphs are cut to the column by counting them.
+  const f32 advance = mFontSize - mFontSize / 7.0f;
+  for (usize row = firstRow; row < lastRow; ++row) {
+    f32 x = columns.x;
+    for (usize column = columns.first; column < columns.last; ++column) {
+      const f32 width = (f32)mColumns.get(column);
+      const auto& glyphs = cell(renderer, row, column).glyphs;
+      renderer.drawGlyphs({glyphs.data(), glyphs.size()}, Vec2{x + CELL_PADDING, y + (mRowHeight - mFontSize) / 2.0f}, mFontSize, mColor, std::floor((width - CELL_PADDING * 2.0f) / advance));
+      x += width;
+    }
+    y += mRowHeight;
+  }
+  mVisibleCells += (lastRow - firstRow) * (columns.last - columns.first);
+
+  // Vertical grid lines, the horizontal ones span the whole table.
+  f32 x = columns.x;
+  for (usize column = columns.first; column < columns.last; ++column) {
+    x += (f32)mColumns.get(column);
+    renderer.drawQuad(Vec2{x - 1.0f, mPosition.y}, Vec2{1.0f, mSize.y}, mGridColor);
+  }
+}
+
+void Table::drawHeaders(Renderer2D& renderer, const Span& columns) {
+  f32 x = columns.x;
+  for (usize column = columns.first; column < columns.last; ++column) {
+    mHeaderText.clear();
+    if (mHeader) {
+      mHeader(column, mHeaderText);
+    } else {
+      columnName(column, mHeaderText);
+    }
+
+    const f32 width = (f32)mColumns.get(column);
+    drawText(renderer, mHeaderText, x, mPosition.y + (mHeaderHeight - mRowHeight) / 2.0f, width);
+    x += width;
+  }
+}
+
+void Table::draw(Renderer2D& renderer) {
+  mFrame++;
+  mStats = {};
+  mVisibleCells = 0;
+
+  const usize columnCount = mColumns.size();
+  const usize frozen = std::min(mFrozenColumns, columnCount);
+  const f32 frozenWidth = (f32)mColumns.offsetOf(frozen);
+  const f32 bodyTop = mPosition.y + mHeaderHeight;
+  const f32 bodyHeight = std::max(0.0f, mSize.y - mHeaderHeight);
+
+  const usize firstRow = std::min(mRows, (usize)(mScrollY / mRowHeight));
+  const usize lastRow  = std::min(mRows, (usize)std::ceil((mScrollY + bodyHeight) / mRowHeight));
+  const f32 rowY = bodyTop - (f32)(mScrollY - (f64)firstRow * mRowHeight);
+
+  const f64 scrollFrom = frozenWidth + mScrollX;
+  const Span scrolling = columnSpan(frozen, columnCount, scrollFrom, scrollFrom + (mSize.x - frozenWidth), mPosition.x + frozenWidth);
+  const Span fixed = columnSpan(0, frozen, 0.0, frozenWidth, mPosition.x);
+
+  // One clip for the whole table, so it is a single batch. Instead of clipping
+  // each area, the frozen columns and the header are drawn over what scrolled
+  // under them.
+  renderer.pushClip(mPosition, mSize);
+  renderer.drawQuad(mPosition, mSize, mBackground);
+
+  drawCells(renderer, scrolling, firstRow, lastRow, rowY);
+  if (frozen != 0) {
+    renderer.drawQuad(Vec2{mPosition.x, bodyTop}, Vec2{frozenWidth, bodyHeight}, mBackground);
+    drawCells(renderer, fixed, firstRow, lastRow, rowY);
+  }
+
+  for (usize row = firstRow; row < lastRow; ++row) {
+    const f32 y = rowY + (f32)(row - firstRow + 1) * mRowHeight;
+    renderer.drawQuad(Vec2{mPosition.x, y - 1.0f}, Vec2{mSize.x, 1.0f}, mGridColor);
+  }
+
+  if (mHeaderHeight > 0.0f) {
+    renderer.drawQuad(mPosition, Vec2{mSize.x, mHeaderHeight}, mHeaderBackground);
+    drawHeaders(renderer, scrolling);
+    if (frozen != 0) {
+      renderer.drawQuad(mPosition, Vec2{frozenWidth, mHeaderHeight}, mHeaderBackground);
+      drawHeaders(renderer, fixed);
+    }
+    renderer.drawQuad(Vec2{mPosition.x, bodyTop - 1.0f}, Vec2{mSize.x, 1.0f}, mGridColor);
+  }
+  renderer.popClip();
+
+  if (mCells.size() > std::max<usize>(mVisibleCells, 256) * 4) {
+    for (auto it = mCells.begin(); it != mCells.end();) {
+      it = it->second.frame == mFrame ? std::next(it) : mCells.erase(it);
+    }
+  }
+}
+
+Table::Handle Table::deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors) {
+  auto id = deserializeId(node["id"], errors);
+
+  auto background = Color::WHITE;
+  if (node["background"]) {
+    background = deserializeColor(node["background"], errors);
+  }
+
+  auto color = Color::BLACK;
+  if (node["color"]) {
+    color = deserializeColor(node["color"], errors);
+  }
+
+  float width = INFINITY;
+  if (node.IsMap() && node["width"] && node["width"].IsScalar()) {
+    width = node["width"].as<float>();
+  }
+
+  float height = INFINITY;
+  if (node.IsMap() && node["height"] && node["height"].IsScalar()) {
+    height = node["height"].as<float>();
+  }
+
+  bool display = true;
+  if (node.IsMap() && node["display"] && node["display"].IsScalar()) {
+    display = node["display"].as<bool>();
+  }
+
+  // The cells come from code, see setCellCallback() and setSize().
+  auto result = Table::create(0, 0, nullptr);
+  result->setId(id);
+  result->setBackground(background);
+  result->setColor(color);
+  result->setWidth(width);
+  result->setHeight(height);
+  result->setDisplay(display);
+
+  if (node.IsMap() && node["row-height"] && node["row-height"].IsScalar()) {
+    result->setRowHeight(node["row-height"].as<float>());
+  }
+  if (node.IsMap() && node["column-width"] && node["column-width"].IsScalar()) {
+    result->setDefaultColumnWidth(node["column-width"].as<float>());
+  }
+  if (node.IsMap() && node["header-height"] && node["header-height"].IsScalar()) {
+    result->setHeaderHeight(node["header-height"].as<float>());
+  }
+  if (node.IsMap() && node["frozen-columns"] && node["frozen-columns"].IsScalar()) {
+    result->setFrozenColumns(node["frozen-columns"].as<usize>());
+  }
+  if (node.IsMap() && node["font-size"] && node["font-size"].IsScalar()) {
+    result->setFontSize(node["font-size"].as<float>());
+  }
+  if (node["header-background"]) {
+    result->setHeaderBackground(deserializeColor(node["header-background"], errors));
+  }
+  return result;
+}
+
+} // namespace Gui
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Core/PrefixSum.hpp"
+#include "Widget/Widget.hpp"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace Gui {
+
+// Grid of `rows` by `columns` cells whose text comes from a callback, with a
+// header row and optionally some frozen leading columns that stay in place
+// while the rest scrolls.
+//
+// Cells are not widgets. Only the cells in view are asked for, their text is
+// laid out into glyphs once and cached while they stay in view, and the whole
+// table is drawn as a single quad batch. Column widths are kept in a PrefixSum, so resizing a column is
+// O(log n) and nothing else is laid out again.
+class Table : public Widget {
+public:
+  using Handle = std::shared_ptr<Table>;
+
+  // Writes the text of a cell into `out`, which is empty.
+  using CellCallback = std::function<void(usize row, usize column, String& out)>;
+
+  // Header text, defaults to spreadsheet style column names: A, B, ..., AA, ...
+  using HeaderCallback = std::function<void(usize column, String& out)>;
+
+  // Of the last frame, cells formatted and laid out, and drawn from their cached glyphs.
+  struct Stats {
+    u32 formatted = 0;
+    u32 cached    = 0;
+  };
+
+public:
+  static Table::Handle create(usize rows, usize columns, CellCallback cell, HeaderCallback header = nullptr);
+
+  Vec2 layout(Constraints constraints) override;
+  void draw(Renderer2D& renderer) override;
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override { return visitor(self); }
+
+  void setCellCallback(CellCallback cell);
+  void setHeaderCallback(HeaderCallback header);
+  void setSize(usize rows, usize columns);
+  inline usize getRowCount() const { return mRows; }
+  inline usize getColumnCount() const { return mColumns.size(); }
+
+  // Drops the cached text of every cell, or of one, after the data changed.
+  void invalidate();
+  void invalidateCell(usize row, usize column);
+
+  void setColumnWidth(usize column, f32 width);
+  inline f32 getColumnWidth(usize column) const { return (f32)mColumns.get(column); }
+  void setDefaultColumnWidth(f32 width);
+  inline void setRowHeight(f32 height) { mRowHeight = height; markDirty(); }
+  inline f32 getRowHeight() const { return mRowHeight; }
+  inline void setHeaderHeight(f32 height) { mHeaderHeight = height; markDirty(); }
+  inline f32 getHeaderHeight() const { return mHeaderHeight; }
+  inline void setFrozenColumns(usize count) { mFrozenColumns = count; markDirty(); }
+  inline usize getFrozenColumns() const { return mFrozenColumns; }
+
+  // Scroll offsets of the body, f64 for the same reason as in ListView.
+  void setScroll(f64 x, f64 y);
+  inline f64 getScrollX() const { return mScrollX; }
+  inline f64 getScrollY() const { return mScrollY; }
+  void scrollBy(f64 x, f64 y);
+  void scrollToCell(usize row, usize column);
+
+  inline void setFontSize(f32 size) { mFontSize = size; markDirty(); }
+  inline void setColor(Vec4 color) { mColor = color; markDirty(); }
+  inline void setBackground(Vec4 color) { mBackground = color; markDirty(); }
+  inline void setHeaderBackground(Vec4 color) { mHeaderBackground = color; markDirty(); }
+  inline void setGridColor(Vec4 color) { mGridColor = color; markDirty(); }
+  inline void setWidth(float size) { mWidth = size; markDirty(); }
+  inline float getWidth() const { return mWidth; }
+  inline void setHeight(float size) { mHeight = size; markDirty(); }
+  inline float getHeight() const { return mHeight; }
+
+  inline const Stats& getStats() const { return mStats; }
+
+  static Table::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors);
+
+public: // Do NOT use these function use the create functions!
+  Table(usize rows, usize columns, CellCallback cell, HeaderCallback header);
+
+private:
+  struct Cell {
+    std::vector<Glyph> glyphs;
+    u32 frame;
+  };
+
+  // Columns [first, last) with the left edge of the first one.
+  struct Span {
+    usize first;
+    usize last;
+    f32   x;
+  };
+
+  Span columnSpan(usize first, usize end, f64 from, f64 to, f32 x) const;
+  void drawCells(Renderer2D& renderer, const Span& columns, usize firstRow, usize lastRow, f32 y);
+  void drawHeaders(Renderer2D& renderer, const Span& columns);
+  void drawText(Renderer2D& renderer, StringView text, f32 x, f32 y, f32 width);
+  const Cell& cell(const Renderer2D& renderer, usize row, usize column);
+
+private:
+  usize mRows;
+  PrefixSum mColumns;
+  CellCallback mCell;
+  HeaderCallback mHeader;
+
+  f32 mDefaultColumnWidth = 96.0f;
+  f32 mRowHeight = 24.0f;
+  f32 mHeaderHeight = 28.0f;
+  usize mFrozenColumns = 0;
+
+  f64 mScrollX = 0.0;
+  f64 mScrollY = 0.0;
+
+  // Glyphs of the cells drawn recently, by row * columns + column. Cells not
+  // drawn in the last frame are dropped once the cache grows too large.
+  std::unordered_map<u64, Cell> mCells;
+  String mCellText;
+  u32 mFrame = 0;
+  usize mVisibleCells = 0;
+  String mHeaderText;
+  Stats mStats;
+
+  f32  mFontSize = 16.0f;
+  Vec4 mColor = Color::BLACK;
+  Vec4 mBackground = Color::WHITE;
+  Vec4 mHeaderBackground = rgba(0xE0E0E0FF);
+  Vec4 mGridColor = rgba(0xC8C8C8FF);
+  float mWidth{INFINITY};
+  float mHeight{INFINITY};
+};
+
+} // namespace Gui
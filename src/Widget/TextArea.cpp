@@ -28,7 +28,7 @@ static std::pair<size_t, size_t> count(const std::string& s) {
 }
 
 TextArea::Handle TextArea::create(OnChangeCallback callback, std::string text, float fontSize) {
-  auto target = std::make_shared<TextArea>(std::move(callback), std::move(text), fontSize);  
+  auto target = makeWidget<TextArea>(std::move(callback), std::move(text), fontSize);  
   auto[lines, maxColumn] = count(target->mEditor.getText());
   target->mLines = lines;
   target->mMaxColumn = maxColumn;
@@ -37,8 +37,9 @@ TextArea::Handle TextArea::create(OnChangeCallback callback, std::string text, f
   target->mFixedWidthSizeWidget  = target->mFitContent;
 
   target->mFocusable = true;
-  target->addKeyEventHandler([=](auto event){
-    if (!target->mFocused) {
+  auto self = target.get();
+  target->addKeyEventHandler([self](auto event){
+    if (!self->mFocused) {
       return false;
     }
 
@@ -47,37 +48,37 @@ TextArea::Handle TextArea::create(OnChangeCallback callback, std::string text, f
     }
 
     if (event.key == Key::Backspace) {
-      if (!target->getText().empty()) {
-        target->mEditor.backspace();
-        target->mOnChange(target->getText());
+      if (!self->getText().empty()) {
+        self->mEditor.backspace();
+        self->mOnChange(self->getText());
       }
       return true;
     } else if (event.key == Key::Enter) {
-      target->mEditor.insertChar('\n');
-      target->mOnChange(target->getText());
+      self->mEditor.insertChar('\n');
+      self->mOnChange(self->getText());
       return true;
     } else if (event.key == Key::Up) {
-      target->mEditor.moveLineUp();
+      self->mEditor.moveLineUp();
     } else if (event.key == Key::Down) {
-      target->mEditor.moveLineDown();
+      self->mEditor.moveLineDown();
     } else if (event.key == Key::Right) {
       if (event.modifier == KeyModifier::Control) {
-        target->mEditor.moveWordRight();
+        self->mEditor.moveWordRight();
       } else {
-        target->mEditor.moveCharRight();
+        self->mEditor.moveCharRight();
       }
     } else if (event.key == Key::Left) {
       if (event.modifier == KeyModifier::Control) {
-        target->mEditor.moveWordLeft();
+        self->mEditor.moveWordLeft();
       } else {
-        target->mEditor.moveCharLeft();
+        self->mEditor.moveCharLeft();
       }
     } else if (event.key == Key::Tab) {
-      target->mEditor.insertBuf("  ", 2);
+      self->mEditor.insertBuf("  ", 2);
     } else if (event.key == Key::Home) {
-      target->mEditor.moveToLineBegin();
+      self->mEditor.moveToLineBegin();
     } else if (event.key == Key::End) {
-      target->mEditor.moveToLineEnd();
+      self->mEditor.moveToLineEnd();
     }
 
     auto ch = getKeyChar(event.key, event.modifier);
@@ -85,8 +86,8 @@ TextArea::Handle TextArea::create(OnChangeCallback callback, std::string text, f
       return false;
     }
 
-    target->mEditor.insertChar(ch);
-    target->mOnChange(target->getText());
+    self->mEditor.insertChar(ch);
+    self->mOnChange(self->getText());
     return true;
   });
   return target;
@@ -106,14 +107,15 @@ Vec2 TextArea::layout(Constraints constraints) {
 void TextArea::draw(Renderer2D& renderer) {
   Vec2 offset = Vec2{4.0f};
   if (mFocused) {
-    renderer.drawQuad(mPosition, mSize, rgba(0xAA2222FF));
-    renderer.drawQuad(mPosition + offset, mSize - offset * 2.0f, mBackground);
+    RectStyle style;
+    style.color       = mBackground;
+    style.borderWidth = offset.x;
+    style.borderColor = rgba(0xAA2222FF);
+    renderer.drawRect(mPosition, mSize, style);
   } else {
     renderer.drawQuad(mPosition, mSize, mBackground);
   }
 
-    // mFocused ? rgba(0xAA2222FF) : rgba(0x222222FF),
-
   auto row    = mEditor.cursorRow();
   auto column = mEditor.cursorColumn();
 
@@ -182,12 +184,14 @@ void TextArea::setText(std::string value) {
 
   mEditor.setText(std::move(value));
   mOnChange(mEditor.getText());
+  markDirty();
 }
 
 void TextArea::setFitContent(bool value) {
   mFixedWidthSizeWidget = value;
   mFixedHeightSizeWidget = value;
   mFitContent = value;
+  markDirty();
 }
 
 } // namespace Gui
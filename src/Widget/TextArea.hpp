@@ -17,9 +17,9 @@ public:
 
   Vec2 layout(Constraints constraints) override;
   void draw(Renderer2D& renderer) override;
-  bool visit(Widget::Handle self, Widget::Visitor& visitor) override { return visitor(self); }
+  bool visit(const Widget::Handle& self, Widget::Visitor& visitor) override { return visitor(self); }
 
-  void setFontSize(float size) { mFontSize = size; }
+  void setFontSize(float size) { mFontSize = size; markDirty(); }
   void setFitContent(bool value);
 
   static TextArea::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors);
@@ -29,9 +29,9 @@ public:
   void setOnChange(OnChangeCallback onChange) { mOnChange = std::move(onChange); }
   
   Vec4 getBackground() const { return mBackground; }
-  void setBackground(Vec4 value) { mBackground = value; }
+  void setBackground(Vec4 value) { mBackground = value; markDirty(); }
   Vec4 getColor() const { return mColor; }
-  void setColor(Vec4 value) { mColor = value; }
+  void setColor(Vec4 value) { mColor = value; markDirty(); }
 
 public: // Do NOT use these function use the create functions!
   TextArea(OnChangeCallback callback, std::string text, float fontSize)
@@ -9,8 +9,13 @@
 #include "Widget/Button.hpp"
 #include "Widget/CheckBox.hpp"
 #include "Widget/TextArea.hpp"
+#include "Widget/Plot.hpp"
+#include "Widget/ListView.hpp"
+#include "Widget/ScrollView.hpp"
+#include "Widget/Table.hpp"
 
 #include <iostream>
+#include <glm/gtc/matrix_transform.hpp>
 #include <regex>
 
 namespace Gui {
@@ -76,7 +81,9 @@ bool compareNodeWithStaticString(const YAML::Node& node, const char* other) {
     return false;
 }
 
-static Widget::Handle deserializeWidget(const YAML::Node& key, const YAML::Node& value, std::vector<DeserializationError>& errors) {
+static void deserializeCommon(const YAML::Node& node, Widget& widget, std::vector<DeserializationError>& errors);
+
+static Widget::Handle deserializeWidgetType(const YAML::Node& key, const YAML::Node& value, std::vector<DeserializationError>& errors) {
   if (compareNodeWithStaticString(key, "row")) {
     return Row::deserialize(value, errors);
   } else if (compareNodeWithStaticString(key, "column")) {
@@ -95,6 +102,14 @@ static Widget::Handle deserializeWidget(const YAML::Node& key, const YAML::Node&
     return CheckBox::deserialize(value, errors);
   } else if (compareNodeWithStaticString(key, "textarea")) {
     return TextArea::deserialize(value, errors);
+  } else if (compareNodeWithStaticString(key, "plot")) {
+    return Plot::deserialize(value, errors);
+  } else if (compareNodeWithStaticString(key, "list-view")) {
+    return ListView::deserialize(value, errors);
+  } else if (compareNodeWithStaticString(key, "table")) {
+    return Table::deserialize(value, errors);
+  } else if (compareNodeWithStaticString(key, "scroll-view")) {
+    return ScrollView::deserialize(value, errors);
   } else {
     insertDeserializationError(errors, value.Mark(), "unknown Widget type");
   }
@@ -102,6 +117,16 @@ static Widget::Handle deserializeWidget(const YAML::Node& key, const YAML::Node&
   return nullptr;
 }
 
+// Every widget is created here, so the common properties apply to the root
+// and to the children of containers alike.
+static Widget::Handle deserializeWidget(const YAML::Node& key, const YAML::Node& value, std::vector<DeserializationError>& errors) {
+  auto result = deserializeWidgetType(key, value, errors);
+  if (result) {
+    deserializeCommon(value, *result, errors);
+  }
+  return result;
+}
+
 std::vector<Widget::Handle> deserializeChildren(const YAML::Node& node, std::vector<DeserializationError>& errors) {
   if(!node) {
     return {};
@@ -144,6 +169,257 @@ void Widget::reportSize() const {
     << std::endl;
 }
 
+void Widget::addClickEventHandler(ClickCallback callback) {
+  // Only use the inline slot while it keeps the handlers in insertion order.
+  if (std::holds_alternative<std::monostate>(mHandler) && (!mHandlers || mHandlers->click.empty())) {
+    mHandler = std::move(callback);
+    return;
+  }
+  if (!mHandlers) {
+    mHandlers = std::make_unique<Handlers>();
+  }
+  mHandlers->click.push_back(std::move(callback));
+}
+
+void Widget::clearClickEventHandlers() {
+  if (std::holds_alternative<ClickCallback>(mHandler)) {
+    mHandler = std::monostate{};
+  }
+  if (mHandlers) {
+    mHandlers->click.clear();
+  }
+}
+
+void Widget::addKeyEventHandler(KeyCallback callback) {
+  if (std::holds_alternative<std::monostate>(mHandler) && (!mHandlers || mHandlers->key.empty())) {
+    mHandler = std::move(callback);
+    return;
+  }
+  if (!mHandlers) {
+    mHandlers = std::make_unique<Handlers>();
+  }
+  mHandlers->key.push_back(std::move(callback));
+}
+
+void Widget::clearKeyEventHandlers() {
+  if (std::holds_alternative<KeyCallback>(mHandler)) {
+    mHandler = std::monostate{};
+  }
+  if (mHandlers) {
+    mHandlers->key.clear();
+  }
+}
+
+void Widget::addScrollEventHandler(ScrollCallback callback) {
+  if (std::holds_alternative<std::monostate>(mHandler) && (!mHandlers || mHandlers->scroll.empty())) {
+    mHandler = std::move(callback);
+    return;
+  }
+  if (!mHandlers) {
+    mHandlers = std::make_unique<Handlers>();
+  }
+  mHandlers->scroll.push_back(std::move(callback));
+}
+
+void Widget::clearScrollEventHandlers() {
+  if (std::holds_alternative<ScrollCallback>(mHandler)) {
+    mHandler = std::monostate{};
+  }
+  if (mHandlers) {
+    mHandlers->scroll.clear();
+  }
+}
+
+void Widget::setTransform(const Transform& transform) {
+  if (!mTransform) {
+    mTransform = std::make_unique<Transform>();
+  }
+  *mTransform = transform;
+  if (parent) {
+    parent->markDirty();
+  }
+}
+
+void Widget::clearTransform() {
+  mTransform = nullptr;
+  if (parent) {
+    parent->markDirty();
+  }
+}
+
+void Widget::setOpacity(f32 opacity) {
+  mOpacity = opacity;
+  if (parent) {
+    parent->markDirty();
+  }
+}
+
+Mat4 Widget::getTransformMatrix() const {
+  Mat4 result = Mat4(1.0f);
+  if (!mTransform) {
+    return result;
+  }
+
+  const Vec2 origin = mPosition + mTransform->origin * mSize;
+  result = glm::translate(result, Vec3(origin + mTransform->translation, 0.0f));
+  if (mTransform->rotation != 0.0f) {
+    result = glm::rotate(result, mTransform->rotation, Vec3{0.0f, 0.0f, 1.0f});
+  }
+  result = glm::scale(result, Vec3(mTransform->scale, 1.0f));
+  result = glm::translate(result, Vec3(-origin, 0.0f));
+  return result;
+}
+
+Widget::Cache::~Cache() {
+  RenderCache::get().release(std::move(target));
+}
+
+void Widget::setCacheMode(CacheMode mode) {
+  mCacheMode = mode;
+  if (mode == CacheMode::Always) {
+    if (!mCache) {
+      mCache = std::make_unique<Cache>();
+    }
+    mCache->automatic = false;
+  } else if (mode == CacheMode::Never || (mCache && !mCache->automatic)) {
+    mCache = nullptr;
+  }
+}
+
+void Widget::cacheAutomatically() {
+  if (mCacheMode == CacheMode::Auto && !mCache) {
+    mCache = std::make_unique<Cache>();
+    mCache->automatic = true;
+  }
+}
+
+void Widget::markDirty() {
+  const u32 frame = RenderCache::get().getFrame();
+  for (Widget* widget = this; widget; widget = widget->parent) {
+    widget->mChangeFrame = frame;
+    if (widget->mCache) {
+      widget->mCache->dirty = true;
+    }
+  }
+}
+
+void Widget::drawCached(Renderer2D& renderer) {
+  auto& cache = RenderCache::get();
+
+  // Whole pixels, so the texels map to the pixels one to one.
+  const Vec2 origin = glm::floor(mPosition);
+  const Vec2 size = glm::ceil(mPosition + mSize) - origin;
+  if (size.x <= 0.0f || size.y <= 0.0f) {
+    draw(renderer);
+    return;
+  }
+
+  const Vec2 fraction = mPosition - origin;
+  if (mCache->dirty || !mCache->target || mCache->size != size || mCache->fraction != fraction) {
+    // An automatic cache that had to be rendered again was a guess that
+    // didn't pay off, wait for the widget to settle again.
+    if (mCache->automatic && mCache->target && mCache->dirty) {
+      mCache = nullptr;
+      draw(renderer);
+      return;
+    }
+
+    if (!cache.acquire((u32)size.x, (u32)size.y, mCache->target)) {
+      draw(renderer);
+      return;
+    }
+
+    // Before drawing, widgets may mark themselves dirty while they draw.
+    mCache->dirty = false;
+    mCache->size = size;
+    mCache->fraction = fraction;
+    renderer.beginTarget(mCache->target, origin);
+    draw(renderer);
+    renderer.endTarget();
+    cache.recordMiss();
+  } else {
+    cache.recordHit();
+  }
+
+  renderer.drawTarget(mCache->target, origin, size);
+}
+
+void Widget::renderComposited(Renderer2D& renderer) {
+  if (mOpacity <= 0.0f) {
+    return;
+  }
+
+  if (mTransform) {
+    renderer.pushTransform(getTransformMatrix());
+  }
+  if (mOpacity != 1.0f) {
+    renderer.pushOpacity(mOpacity);
+  }
+  if (renderer.isVisible(mPosition, mSize)) {
+    if (mCache) {
+      drawCached(renderer);
+    } else {
+      draw(renderer);
+    }
+  }
+  if (mOpacity != 1.0f) {
+    renderer.popOpacity();
+  }
+  if (mTransform) {
+    renderer.popTransform();
+  }
+}
+
+static Vec2 deserializeVec2(const YAML::Node& node, Vec2 value, std::vector<DeserializationError>& errors) {
+  if (node.IsScalar()) {
+    const f32 scalar = node.as<f32>();
+    return {scalar, scalar};
+  }
+  if (node.IsSequence() && node.size() == 2) {
+    return {node[0].as<f32>(), node[1].as<f32>()};
+  }
+  insertDeserializationError(errors, node.Mark(), "Expected a number or a sequence of two numbers");
+  return value;
+}
+
+// Properties every widget has.
+static void deserializeCommon(const YAML::Node& node, Widget& widget, std::vector<DeserializationError>& errors) {
+  if (!node.IsMap()) {
+    return;
+  }
+
+  if (node["opacity"] && node["opacity"].IsScalar()) {
+    widget.setOpacity(node["opacity"].as<f32>());
+  }
+
+  // true, false or auto.
+  if (node["cache"] && node["cache"].IsScalar()) {
+    const auto value = node["cache"].as<std::string>();
+    if (value == "auto") {
+      widget.setCacheMode(Widget::CacheMode::Auto);
+    } else {
+      widget.setCacheMode(node["cache"].as<bool>() ? Widget::CacheMode::Always : Widget::CacheMode::Never);
+    }
+  }
+
+  if (node["translate"] || node["scale"] || node["rotate"]) {
+    Widget::Transform transform;
+    if (node["translate"]) {
+      transform.translation = deserializeVec2(node["translate"], transform.translation, errors);
+    }
+    if (node["scale"]) {
+      transform.scale = deserializeVec2(node["scale"], transform.scale, errors);
+    }
+    if (node["rotate"] && node["rotate"].IsScalar()) {
+      transform.rotation = glm::radians(node["rotate"].as<f32>());
+    }
+    if (node["origin"]) {
+      transform.origin = deserializeVec2(node["origin"], transform.origin, errors);
+    }
+    widget.setTransform(transform);
+  }
+}
+
 Widget::Handle Widget::deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors) {
   if (!node.IsMap()) {
     insertDeserializationError(errors, node.Mark(), "Widget name is not a map");
@@ -164,4 +440,9 @@ Widget::Handle Widget::deserialize(const YAML::Node& node, std::vector<Deseriali
   return deserializeWidget(pair->first, pair->second, errors);
 }
 
+Widget::Handle Widget::deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors, const WidgetArena::Handle& arena) {
+  WidgetArena::Scope scope(arena);
+  return deserialize(node, errors);
+}
+
 } // namespace Gui
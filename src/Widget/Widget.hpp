@@ -1,10 +1,15 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <variant>
 #include <vector>
 
+#include "Core/Symbol.hpp"
 #include "Widget/Constraints.hpp"
+#include "Widget/WidgetArena.hpp"
 #include "Renderer/Renderer2D.hpp"
+#include "Renderer/RenderCache.hpp"
 #include "Events/KeyEvent.hpp"
 #include <yaml-cpp/yaml.h>
 
@@ -19,7 +24,7 @@ struct DeserializationError {
 class Widget {
 public:
     using Handle = std::shared_ptr<Widget>;
-    using Visitor = std::function<bool(Widget::Handle)>;
+    using Visitor = std::function<bool(const Widget::Handle&)>;
 
 public:
     struct ClickEvent {
@@ -42,57 +47,205 @@ public:
     };
     using KeyCallback = std::function<bool(KeyEvent)>;
 
+    // Pixels scrolled per notch of the mouse wheel.
+    static constexpr const f32 SCROLL_STEP = 48.0f;
+
+    // Goes to the widgets under the mouse, innermost first, until a handler
+    // returns false. Return true when there is nothing left to scroll, so the
+    // widget around it scrolls instead.
+    struct ScrollEvent {
+      Widget::Handle target;
+      Vec2 position;
+      Vec2 offset;
+    };
+    using ScrollCallback = std::function<bool(ScrollEvent)>;
+
+    // Moves the widget and everything in it where it is drawn, without
+    // changing the layout. Scaling and rotation are around `origin`, relative
+    // to the widget's size.
+    struct Transform {
+      Vec2 translation{0.0f};
+      Vec2 scale{1.0f};
+      f32  rotation = 0.0f; // In radians
+      Vec2 origin{0.5f};
+    };
+
+    // Whether the widget is rendered into a texture once and then drawn as a
+    // single quad, until it or something in it is marked dirty. Auto leaves
+    // it to the application, which caches the widget when its subtree is
+    // large and hasn't changed for a while and stops as soon as it changes.
+    // Widgets are never cached unless they opt in.
+    enum class CacheMode : u8 {
+      Auto,
+      Always,
+      Never,
+    };
+
 public:
     virtual ~Widget() = default;
 
     virtual Vec2 layout(Constraints constraints) = 0;
     virtual void reportSize() const;
-    virtual bool visit(Widget::Handle self, Widget::Visitor& visitor) = 0;
+    virtual bool visit(const Widget::Handle& self, Widget::Visitor& visitor) = 0;
     virtual void draw(Renderer2D& renderer) = 0;
+    virtual Slice<const Widget::Handle> getChildren() const { return {static_cast<const Widget::Handle*>(nullptr), 0}; }
+
+    // Draws the widget if it is in view, with its transform and opacity. Use
+    // this rather than draw() to draw children.
+    inline void render(Renderer2D& renderer) {
+      if (!mTransform && mOpacity == 1.0f && !mCache) {
+        if (renderer.isVisible(mPosition, mSize)) {
+          draw(renderer);
+        }
+        return;
+      }
+      renderComposited(renderer);
+    }
+
+    // Changing the transform or opacity of a cached widget doesn't render it again.
+    void setTransform(const Transform& transform);
+    void clearTransform();
+    inline const Transform* getTransform() const { return mTransform.get(); }
+
+    // Identity without a transform.
+    Mat4 getTransformMatrix() const;
+
+    // Of the widget and everything in it.
+    void setOpacity(f32 opacity);
+    inline f32 getOpacity() const { return mOpacity; }
+
+    void setCacheMode(CacheMode mode);
+    inline CacheMode getCacheMode() const { return mCacheMode; }
+    inline bool isCached() const { return mCache != nullptr; }
+
+    // Caches the widget if its mode is Auto, until it is marked dirty.
+    void cacheAutomatically();
+
+    // Renders the cached ancestors again. The setters of the built-in widgets
+    // and handling their events do this, other changes to what a widget draws
+    // have to call it.
+    void markDirty();
+
+    // Frame of the last markDirty() of the widget or something in it, see RenderCache::getFrame().
+    inline u32 getChangeFrame() const { return mChangeFrame; }
+
+    // Counts the children removed from their parents, so raw pointers into a
+    // tree can be checked for still being in it, see WidgetTree::isStale().
+    static inline u32 getDetachCount() { return sDetachCount; }
+
+    // Where the children are drawn relative to their layout position, and
+    // whether they are clipped to this widget. Hit-testing uses the same.
+    virtual Vec2 getChildOffset() const { return Vec2{0.0f}; }
+    virtual bool clipsChildren() const { return false; }
+
+    // Called by the application before every frame's layout while the widget
+    // is animating, with the seconds since the last frame.
+    virtual bool isAnimating() const { return false; }
+    virtual void animate(f32 dt) { (void)dt; }
 
     void setPosition(Vec2 position) { mPosition = position; }
+    inline bool contains(Vec2 point) const {
+      return mPosition.x <= point.x
+        && mPosition.y <= point.y
+        && mPosition.x + mSize.x > point.x
+        && mPosition.y + mSize.y > point.y;
+    }
+
+    void addClickEventHandler(ClickCallback callback);
+    void clearClickEventHandlers();
+    inline bool hasClickEventHandler() const {
+      return std::holds_alternative<ClickCallback>(mHandler) || (mHandlers && !mHandlers->click.empty());
+    }
 
-    inline void addClickEventHandler(ClickCallback callback) { mClickCallbacks.push_back(callback); }
-    inline void clearClickEventHandlers() { mClickCallbacks.clear(); }
-    inline bool hasClickEventHandler() { return !mClickCallbacks.empty(); }
+    void addKeyEventHandler(KeyCallback callback);
+    void clearKeyEventHandlers();
+    inline bool hasKeyEventHandler() const {
+      return std::holds_alternative<KeyCallback>(mHandler) || (mHandlers && !mHandlers->key.empty());
+    }
 
-    inline void addKeyEventHandler(KeyCallback callback) { mKeyCallbacks.push_back(callback); }
-    inline void clearKeyEventHandlers() { mKeyCallbacks.clear(); }
-    inline bool hasKeyEventHandler() { return !mKeyCallbacks.empty(); }
+    void addScrollEventHandler(ScrollCallback callback);
+    void clearScrollEventHandlers();
+    inline bool hasScrollEventHandler() const {
+      return std::holds_alternative<ScrollCallback>(mHandler) || (mHandlers && !mHandlers->scroll.empty());
+    }
 
     template<typename T>
     inline T* as() { return dynamic_cast<T*>(this); }
 
     inline bool click(ClickEvent event) {
       bool handled = false;
-      for (auto& handler : mClickCallbacks) {
-        handled = handled || handler(event);
+      if (auto handler = std::get_if<ClickCallback>(&mHandler)) {
+        handled = (*handler)(event);
+      }
+      if (mHandlers) {
+        for (auto& handler : mHandlers->click) {
+          handled = handled || handler(event);
+        }
       }
       return handled;
     }
 
     inline bool triggerKeyEvent(KeyEvent event) {
       bool handled = false;
-      for (auto& handler : mKeyCallbacks) {
-        handled = handled || handler(event);
+      if (auto handler = std::get_if<KeyCallback>(&mHandler)) {
+        handled = (*handler)(event);
+      }
+      if (mHandlers) {
+        for (auto& handler : mHandlers->key) {
+          handled = handled || handler(event);
+        }
       }
       return handled;
     }
 
+    inline bool scroll(ScrollEvent event) {
+      bool propagate = true;
+      if (auto handler = std::get_if<ScrollCallback>(&mHandler)) {
+        propagate = (*handler)(event);
+      }
+      if (mHandlers) {
+        for (auto& handler : mHandlers->scroll) {
+          propagate = propagate && handler(event);
+        }
+      }
+      return propagate;
+    }
+
     inline bool isFocusable() const { return mFocusable; }
-    inline const std::string& getId() const { return mId; }
-    inline void setId(std::string id) { mId = id; }
+    inline StringView getId() const { return mId.toString(); }
+    inline Symbol getIdSymbol() const { return mId; }
+    inline void setId(StringView id) { mId = Symbol::intern(id); }
     inline bool getDisplay() const { return mDisplay; }
-    inline void setDisplay(bool value) { mDisplay = value; }
+    inline void setDisplay(bool value) {
+      if (mDisplay != value) {
+        mDisplay = value;
+        markDirty();
+      }
+    }
 
     static Widget::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors);
+
+    // Same as above, but the whole tree is allocated from the given arena.
+    static Widget::Handle deserialize(const YAML::Node& node, std::vector<DeserializationError>& errors, const WidgetArena::Handle& arena);
 protected:
     Widget() = default;
     Widget(Vec2 size) : mSize{size} {}
 
+    // To be called by widgets with children on every child they let go of.
+    static inline void detach(Widget& child) {
+      child.parent = nullptr;
+      sDetachCount++;
+    }
+
+private:
+    static inline u32 sDetachCount = 0;
+
+    void renderComposited(Renderer2D& renderer);
+    void drawCached(Renderer2D& renderer);
+
 public:
     Widget* parent = nullptr;
-    std::string mId;
+    Symbol mId;
 
     Vec2 mPosition{};
     Vec2 mSize{};
@@ -103,8 +256,37 @@ public:
     bool mFixedHeightSizeWidget = false;
     bool mDisplay = true;
 
-    std::vector<ClickCallback> mClickCallbacks{};
-    std::vector<KeyCallback> mKeyCallbacks{};
+    // Most widgets have at most one handler, so the first one is stored inline
+    // and only the rest go to the heap.
+    struct Handlers {
+      std::vector<ClickCallback> click;
+      std::vector<KeyCallback> key;
+      std::vector<ScrollCallback> scroll;
+    };
+
+    std::variant<std::monostate, ClickCallback, KeyCallback, ScrollCallback> mHandler{};
+    std::unique_ptr<Handlers> mHandlers{};
+
+    // Few widgets have one, so it's on the heap.
+    std::unique_ptr<Transform> mTransform{};
+    f32 mOpacity = 1.0f;
+
+    struct Cache {
+      FrameBuffer::Handle target;
+      Vec2 size{0.0f};
+
+      // Of the widget within its first pixel, the content moves with it.
+      Vec2 fraction{0.0f};
+      bool dirty = true;
+      bool automatic = false;
+
+      // Returns the target to the RenderCache.
+      ~Cache();
+    };
+
+    std::unique_ptr<Cache> mCache{};
+    CacheMode mCacheMode = CacheMode::Never;
+    u32 mChangeFrame = RenderCache::get().getFrame();
 };
 
 void insertDeserializationError(std::vector<DeserializationError>& errors, YAML::Mark mark, std::string message);
@@ -0,0 +1,65 @@
+#include "Widget/WidgetArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Gui {
+
+static thread_local WidgetArena* sCurrentArena = nullptr;
+
+WidgetArena::Scope::Scope(const WidgetArena::Handle& arena)
+  : mPrevious{sCurrentArena}
+{
+  sCurrentArena = arena.get();
+}
+
+WidgetArena::Scope::~Scope() {
+  sCurrentArena = mPrevious;
+}
+
+WidgetArena::Handle WidgetArena::create(usize blockSize) {
+  return std::make_shared<WidgetArena>(blockSize);
+}
+
+WidgetArena::~WidgetArena() {
+  for (auto& block : mBlocks) {
+    delete[] block.data;
+  }
+}
+
+WidgetArena* WidgetArena::current() {
+  return sCurrentArena;
+}
+
+void* WidgetArena::allocate(usize size, usize alignment) {
+  GUI_DEBUG_ASSERT((alignment & (alignment - 1)) == 0);
+
+  if (!mBlocks.empty()) {
+    auto& block = mBlocks.back();
+    auto address = reinterpret_cast<uintptr_t>(block.data) + mOffset;
+    auto padding = (alignment - address % alignment) % alignment;
+    if (mOffset + padding + size <= block.size) {
+      mOffset += padding + size;
+      mUsed   += size;
+      return block.data + mOffset - size;
+    }
+  }
+
+  // new[] returns memory aligned for any fundamental type, which is all widgets need.
+  GUI_ASSERT(alignment <= alignof(std::max_align_t));
+  auto blockSize = std::max(mBlockSize, size);
+  mBlocks.push_back({new u8[blockSize], blockSize});
+  mOffset = size;
+  mUsed  += size;
+  return mBlocks.back().data;
+}
+
+usize WidgetArena::getCapacity() const {
+  usize capacity = 0;
+  for (auto& block : mBlocks) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+} // namespace Gui
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Core/Base.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace Gui {
+
+// Contiguous storage for a widget tree.
+//
+// While a WidgetArena::Scope is alive, widgets created on that thread (and
+// their shared_ptr control blocks) are allocated linearly from the arena, so
+// a tree built in one go (e.g. by Widget::deserialize) ends up laid out in
+// depth-first order in a few large blocks instead of scattered over the heap.
+//
+// Every widget keeps the arena alive; the memory is released as a unit when
+// the last widget of the tree is destroyed.
+class WidgetArena : public std::enable_shared_from_this<WidgetArena> {
+public:
+  using Handle = std::shared_ptr<WidgetArena>;
+
+  static constexpr const usize DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+  class Scope {
+  public:
+    Scope(const WidgetArena::Handle& arena);
+    DISALLOW_MOVE_AND_COPY(Scope);
+    ~Scope();
+
+  private:
+    WidgetArena* mPrevious;
+  };
+
+public:
+  static WidgetArena::Handle create(usize blockSize = DEFAULT_BLOCK_SIZE);
+  DISALLOW_MOVE_AND_COPY(WidgetArena);
+  ~WidgetArena();
+
+  // The arena of the innermost scope on this thread, if any.
+  static WidgetArena* current();
+
+  void* allocate(usize size, usize alignment);
+
+  inline usize getUsed() const { return mUsed; }
+  usize getCapacity() const;
+
+public:
+  // DO NOT USE! Use WidgetArena::create()
+  WidgetArena(usize blockSize)
+    : mBlockSize{blockSize}
+  {}
+
+private:
+  struct Block {
+    u8* data;
+    usize size;
+  };
+
+private:
+  usize mBlockSize;
+  std::vector<Block> mBlocks;
+  usize mOffset = 0;
+  usize mUsed   = 0;
+};
+
+template<typename T>
+class WidgetArenaAllocator {
+public:
+  using value_type = T;
+
+public:
+  WidgetArenaAllocator(WidgetArena::Handle arena)
+    : mArena{std::move(arena)}
+  {}
+
+  template<typename U>
+  WidgetArenaAllocator(const WidgetArenaAllocator<U>& other)
+    : mArena{other.getArena()}
+  {}
+
+  inline T* allocate(usize count) { return static_cast<T*>(mArena->allocate(sizeof(T) * count, alignof(T))); }
+  inline void deallocate(T*, usize) {}
+
+  inline const WidgetArena::Handle& getArena() const { return mArena; }
+
+  template<typename U>
+  inline bool operator==(const WidgetArenaAllocator<U>& other) const { return mArena == other.getArena(); }
+  template<typename U>
+  inline bool operator!=(const WidgetArenaAllocator<U>& other) const { return mArena != other.getArena(); }
+
+private:
+  WidgetArena::Handle mArena;
+};
+
+// Allocates the widget from the current arena, if there is one.
+template<typename T, typename... Args>
+std::shared_ptr<T> makeWidget(Args&&... args) {
+  if (auto arena = WidgetArena::current()) {
+    return std::allocate_shared<T>(WidgetArenaAllocator<T>(arena->shared_from_this()), std::forward<Args>(args)...);
+  }
+  return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+} // namespace Gui
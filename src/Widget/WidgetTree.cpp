@@ -0,0 +1,174 @@
+#include "Widget/WidgetTree.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Gui {
+
+void WidgetTree::clear() {
+  mMinX.clear();
+  mMinY.clear();
+  mMaxX.clear();
+  mMaxY.clear();
+  mFlags.clear();
+  mParent.clear();
+  mFirstChild.clear();
+  mNextSibling.clear();
+  mWidgets.clear();
+  mRoot = nullptr;
+}
+
+void WidgetTree::rebuild(const Widget::Handle& root) {
+  clear();
+  mRoot = root;
+  mDetachCount = Widget::getDetachCount();
+  if (root) {
+    constexpr const f32 INF = std::numeric_limits<f32>::infinity();
+    add(root.get(), true, Vec2{0.0f}, nullptr, {Vec2{-INF}, Vec2{INF}});
+  }
+}
+
+Widget::Handle WidgetTree::getHandle(Id id) const {
+  const Id parent = mParent[id];
+  if (parent == NONE) {
+    return mRoot;
+  }
+  for (const auto& child : mWidgets[parent]->getChildren()) {
+    if (child.get() == mWidgets[id]) {
+      return child;
+    }
+  }
+  return nullptr;
+}
+
+WidgetTree::Bounds WidgetTree::transformBounds(const Mat4& transform, const Bounds& bounds) {
+  const Vec2 corners[] = {
+    bounds.min,
+    {bounds.max.x, bounds.min.y},
+    {bounds.min.x, bounds.max.y},
+    bounds.max,
+  };
+
+  Bounds result = {Vec2(transform * Vec4(corners[0], 0.0f, 1.0f)), Vec2{0.0f}};
+  result.max = result.min;
+  for (const auto& corner : corners) {
+    const Vec2 point = Vec2(transform * Vec4(corner, 0.0f, 1.0f));
+    result.min = glm::min(result.min, point);
+    result.max = glm::max(result.max, point);
+  }
+  return result;
+}
+
+WidgetTree::Id WidgetTree::add(Widget* widget, bool parentVisible, Vec2 offset, const Mat4* transform, const Bounds& clip) {
+  const bool visible = parentVisible && widget->getDisplay();
+
+  // The offset is folded into the matrix once there is one, so the common
+  // case of no transforms stays a couple of additions.
+  Mat4 matrix;
+  if (widget->getTransform()) {
+    matrix = transform ? *transform : Mat4(1.0f);
+    matrix = glm::translate(matrix, Vec3(offset, 0.0f)) * widget->getTransformMatrix();
+    transform = &matrix;
+    offset = Vec2{0.0f};
+  }
+
+  Bounds bounds = {widget->mPosition + offset, widget->mPosition + widget->mSize + offset};
+  if (transform) {
+    bounds = transformBounds(*transform, bounds);
+  }
+
+  // An empty box is never hit, min <= point < max can't hold.
+  bounds.min = glm::max(bounds.min, clip.min);
+  bounds.max = glm::max(bounds.min, glm::min(bounds.max, clip.max));
+
+  Id firstChild = NONE;
+  Id previous   = NONE;
+  auto children = widget->getChildren();
+  const Vec2 childOffset = offset + widget->getChildOffset();
+  const Bounds& childClip = widget->clipsChildren() ? bounds : clip;
+  for (auto& child : children) {
+    const Id id = add(child.get(), visible, childOffset, transform, childClip);
+    if (previous == NONE) {
+      firstChild = id;
+    } else {
+      mNextSibling[previous] = id;
+    }
+    previous = id;
+  }
+
+  u16 flags = 0;
+  if (visible)                          flags |= Visible;
+  if (widget->isFocusable())            flags |= Focusable;
+  if (widget->mFocused)                 flags |= Focused;
+  if (widget->hasClickEventHandler())   flags |= Clickable;
+  if (widget->hasKeyEventHandler())     flags |= KeyListener;
+  if (widget->mFixedWidthSizeWidget)    flags |= FixedWidth;
+  if (widget->mFixedHeightSizeWidget)   flags |= FixedHeight;
+  if (widget->hasScrollEventHandler())  flags |= Scrollable;
+  if (widget->isAnimating())            flags |= Animated;
+
+  const Id id = (Id)mWidgets.size();
+  mMinX.push_back(bounds.min.x);
+  mMinY.push_back(bounds.min.y);
+  mMaxX.push_back(bounds.max.x);
+  mMaxY.push_back(bounds.max.y);
+  mFlags.push_back(flags);
+  mParent.push_back(NONE);
+  mFirstChild.push_back(firstChild);
+  mNextSibling.push_back(NONE);
+  mWidgets.push_back(widget);
+
+  for (Id child = firstChild; child != NONE; child = mNextSibling[child]) {
+    mParent[child] = id;
+  }
+  return id;
+}
+
+WidgetTree::Id WidgetTree::findAt(Vec2 point, u16 flags, Id start) const {
+  // Test a chunk of nodes without branching so the compiler can vectorize
+  // it, then look for the first hit in the chunk.
+  constexpr const Id CHUNK = 64;
+
+  const Id count = (Id)mWidgets.size();
+  for (Id begin = start; begin < count; begin += CHUNK) {
+    const Id end = std::min(count, begin + CHUNK);
+
+    u8 hits[CHUNK];
+    for (Id i = begin; i < end; ++i) {
+      hits[i - begin] = (mMinX[i] <= point.x)
+                      & (mMinY[i] <= point.y)
+                      & (mMaxX[i] >  point.x)
+                      & (mMaxY[i] >  point.y)
+                      & ((mFlags[i] & flags) == flags);
+    }
+
+    for (Id i = begin; i < end; ++i) {
+      if (hits[i - begin]) {
+        return i;
+      }
+    }
+  }
+  return NONE;
+}
+
+void WidgetTree::collectVisible(Vec2 position, Vec2 size, std::vector<Id>& result) const {
+  const f32 minX = position.x;
+  const f32 minY = position.y;
+  const f32 maxX = position.x + size.x;
+  const f32 maxY = position.y + size.y;
+
+  const Id count = (Id)mWidgets.size();
+  for (Id i = 0; i < count; ++i) {
+    const bool intersects = (mMinX[i] < maxX)
+                          & (mMinY[i] < maxY)
+                          & (mMaxX[i] > minX)
+                          & (mMaxY[i] > minY)
+                          & ((mFlags[i] & Visible) != 0);
+    if (intersects) {
+      result.push_back(i);
+    }
+  }
+}
+
+} // namespace Gui
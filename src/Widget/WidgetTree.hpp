@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Core/Base.hpp"
+#include "Widget/Widget.hpp"
+
+#include <vector>
+
+namespace Gui {
+
+// Flat snapshot of a laid out widget tree.
+//
+// The fields that layout results, hit-testing and culling read are kept in
+// parallel arrays indexed by node id, the hierarchy as parent/first-child/
+// next-sibling links. The widgets themselves are only needed for the cold
+// data (callbacks, text, ...).
+//
+// Bounds are where the widget is drawn, that is moved by the child offsets of
+// its ancestors (see Widget::getChildOffset()), by its and their transforms,
+// and cut by their clips. Rotated widgets are hit by their bounding boxes.
+//
+// Nodes are stored in post-order, the same order Widget::visit() uses, so a
+// linear scan returning the first match behaves like the equivalent visitor.
+//
+// Only the root is referenced, the other widgets are kept as raw pointers so a
+// rebuild doesn't touch their reference counts. They stay valid while the tree
+// has the same root and no widget was detached from its parent, see isStale().
+class WidgetTree {
+public:
+  using Id = u32;
+  static constexpr const Id NONE = UINT32_MAX;
+
+  enum Flag : u16 {
+    // The widget and all its ancestors are displayed.
+    Visible     = 0b0000'0001,
+    Focusable   = 0b0000'0010,
+    Focused     = 0b0000'0100,
+    Clickable   = 0b0000'1000,
+    KeyListener = 0b0001'0000,
+    FixedWidth  = 0b0010'0000,
+    FixedHeight = 0b0100'0000,
+    Scrollable  = 0b1000'0000,
+    Animated    = 0b0000'0001'0000'0000,
+  };
+
+public:
+  // Rebuilds the snapshot, to be called after layout. Keeps the storage of
+  // the previous snapshot, so rebuilding a tree of the same size doesn't allocate.
+  void rebuild(const Widget::Handle& root);
+  void clear();
+
+  // Whether the tree changed such that the widgets of the snapshot may be gone.
+  inline bool isStale(const Widget::Handle& root) const {
+    return root != mRoot || Widget::getDetachCount() != mDetachCount;
+  }
+
+  inline usize size() const { return mWidgets.size(); }
+  inline bool isEmpty() const { return mWidgets.empty(); }
+
+  // First node (in post-order) that contains the point and has all the given flags.
+  Id findAt(Vec2 point, u16 flags = Visible, Id start = 0) const;
+
+  // Visible nodes that intersect the rectangle, in post-order.
+  void collectVisible(Vec2 position, Vec2 size, std::vector<Id>& result) const;
+
+  inline Widget* getWidget(Id id) const { return mWidgets[id]; }
+
+  // A reference to the widget, found in its parent's children.
+  Widget::Handle getHandle(Id id) const;
+  inline Vec2 getPosition(Id id) const { return {mMinX[id], mMinY[id]}; }
+  inline Vec2 getSize(Id id) const { return {mMaxX[id] - mMinX[id], mMaxY[id] - mMinY[id]}; }
+  inline u16 getFlags(Id id) const { return mFlags[id]; }
+  inline bool hasFlags(Id id, u16 flags) const { return (mFlags[id] & flags) == flags; }
+  inline Id getParent(Id id) const { return mParent[id]; }
+  inline Id getFirstChild(Id id) const { return mFirstChild[id]; }
+  inline Id getNextSibling(Id id) const { return mNextSibling[id]; }
+  inline Id getRoot() const { return mWidgets.empty() ? NONE : Id(mWidgets.size() - 1); }
+
+  // Number of nodes in the subtree, the node included. In post-order they are
+  // the ids up to the node, starting from its leftmost leaf.
+  inline u32 getSubtreeSize(Id id) const {
+    Id first = id;
+    while (mFirstChild[first] != NONE) {
+      first = mFirstChild[first];
+    }
+    return id - first + 1;
+  }
+
+private:
+  struct Bounds {
+    Vec2 min;
+    Vec2 max;
+  };
+
+  static Bounds transformBounds(const Mat4& transform, const Bounds& bounds);
+
+  // `transform` is null while no ancestor has a transform.
+  Id add(Widget* widget, bool parentVisible, Vec2 offset, const Mat4* transform, const Bounds& clip);
+
+private:
+  // Hot
+  std::vector<f32> mMinX;
+  std::vector<f32> mMinY;
+  std::vector<f32> mMaxX;
+  std::vector<f32> mMaxY;
+  std::vector<u16> mFlags;
+
+  // Hierarchy
+  std::vector<Id> mParent;
+  std::vector<Id> mFirstChild;
+  std::vector<Id> mNextSibling;
+
+  // Cold
+  std::vector<Widget*> mWidgets;
+  Widget::Handle mRoot;
+  u32 mDetachCount = 0;
+};
+
+} // namespace Gui
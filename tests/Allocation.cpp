@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Gui.hpp>
+
+#include "AllocationTracker.hpp"
+
+using namespace Gui;
+using Gui::Tests::AllocationStats;
+using Gui::Tests::AllocationTracker;
+
+namespace {
+
+  bool hasWindowSystem() {
+    static bool available = Window::create("LibGUI - Probe", 64, 64, false) != nullptr;
+    return available;
+  }
+
+  class TestApplication : public Application {
+  public:
+    TestApplication()
+      : Application("LibGUI - Allocation Tests", 640, 480)
+    {
+      getWindow()->setVisible(false);
+      getWindow()->setVSync(false);
+
+      input  = Input::create([](auto&) {}, "hello world", 16);
+      button = Button::create([](auto) { return true; }, "Submit", 16);
+
+      auto column = Column::create();
+      column->addChild(Label::create("Allocation\nTests", 16));
+      column->addChild(input);
+      column->addChild(button);
+      column->addChild(CheckBox::create([](bool) {}));
+      column->addChild(TextArea::create([](auto&) {}, "line 1\nline 2", 16));
+      column->addChild(SizedBox::create(32.0f, 32.0f));
+      root = column;
+    }
+
+  public:
+    Widget::Handle input;
+    Widget::Handle button;
+  };
+
+  // Shared by all the tests, GPU resources are cached per process.
+  TestApplication& getApplication() {
+    static TestApplication application;
+    return application;
+  }
+
+} // namespace
+
+TEST_CASE("Steady-state frames do not allocate", "[allocation]") {
+  if (!hasWindowSystem()) {
+    SKIP("No window system available");
+  }
+
+  auto& application = getApplication();
+
+  // The first frames fill caches (uniform locations, ...).
+  for (int i = 0; i < 3; ++i) {
+    application.logicLoop();
+  }
+
+  for (int frame = 0; frame < 100; ++frame) {
+    AllocationTracker::start();
+    application.logicLoop();
+    AllocationStats stats = AllocationTracker::stop();
+
+    INFO("frame " << frame << ": " << stats.count << " allocations, " << stats.bytes << " bytes");
+    REQUIRE(stats.count == 0);
+  }
+}
+
+TEST_CASE("Dispatching input events does not allocate", "[allocation]") {
+  if (!hasWindowSystem()) {
+    SKIP("No window system available");
+  }
+
+  auto& application = getApplication();
+  application.logicLoop();
+
+  const Vec2 position = application.input->mPosition + Vec2{2.0f, 2.0f};
+  const MouseMoveEvent move(position.x, position.y);
+  const MouseButtonPressedEvent press(MouseButton::Left);
+  const KeyPressedEvent backspace(Key::Backspace, KeyModifier::None, false);
+  const KeyReleasedEvent release(Key::Backspace);
+
+  auto dispatch = [&] {
+    application.onEvent(move);
+    application.onEvent(press);
+    application.onEvent(backspace);
+    application.onEvent(release);
+    application.logicLoop();
+  };
+
+  dispatch();
+
+  for (int frame = 0; frame < 20; ++frame) {
+    AllocationTracker::start();
+    dispatch();
+    AllocationStats stats = AllocationTracker::stop();
+
+    INFO("frame " << frame << ": " << stats.count << " allocations, " << stats.bytes << " bytes");
+    REQUIRE(stats.count == 0);
+  }
+}
@@ -0,0 +1,112 @@
+#include "AllocationTracker.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#  include <malloc.h>
+#endif
+
+namespace Gui::Tests {
+
+  static thread_local bool sTracking = false;
+  static thread_local AllocationStats sStats;
+
+  void AllocationTracker::start() {
+    sStats = {};
+    sTracking = true;
+  }
+
+  AllocationStats AllocationTracker::stop() {
+    sTracking = false;
+    return sStats;
+  }
+
+  static void* allocate(std::size_t size) {
+    if (sTracking) {
+      sStats.count++;
+      sStats.bytes += size;
+    }
+    if (size == 0) {
+      size = 1;
+    }
+    return std::malloc(size);
+  }
+
+  static void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    if (sTracking) {
+      sStats.count++;
+      sStats.bytes += size;
+    }
+    const auto align = static_cast<std::size_t>(alignment);
+    size = (size + align - 1) / align * align;
+    if (size == 0) {
+      size = align;
+    }
+  #ifdef _WIN32
+    return _aligned_malloc(size, align);
+  #else
+    return std::aligned_alloc(align, size);
+  #endif
+  }
+
+  static void deallocateAligned(void* ptr) {
+  #ifdef _WIN32
+    _aligned_free(ptr);
+  #else
+    std::free(ptr);
+  #endif
+  }
+
+} // namespace Gui::Tests
+
+using Gui::Tests::allocate;
+using Gui::Tests::allocateAligned;
+using Gui::Tests::deallocateAligned;
+
+void* operator new(std::size_t size) {
+  if (void* ptr = allocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  if (void* ptr = allocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  if (void* ptr = allocateAligned(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  if (void* ptr = allocateAligned(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept                                 { std::free(ptr); }
+void operator delete[](void* ptr) noexcept                               { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept                    { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept                  { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept          { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept        { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept                  { deallocateAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept                { deallocateAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept     { deallocateAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept   { deallocateAligned(ptr); }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Gui::Tests {
+
+  struct AllocationStats {
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+  };
+
+  // Counts calls to the global operator new made by the current thread between
+  // start() and stop(). Linking AllocationTracker.cpp replaces the global
+  // operator new/delete of the whole executable.
+  //
+  // Plain malloc is not hooked: the OpenGL driver and the windowing system
+  // allocate with it on their own schedule, which would make the counts
+  // depend on the machine rather than on our code.
+  class AllocationTracker {
+  public:
+    static void start();
+    static AllocationStats stop();
+  };
+
+} // namespace Gui::Tests